@@ -2,13 +2,20 @@
  * @brief PINKIE - Microchip ATmega328 Architecture
  *
  * Info:
- *   - UART is non-blocking and has 50 bytes buffer
+ *   - UART receive is interrupt driven with PINKIE_ARCH_UART_RX_LEN bytes
+ *     buffer, received characters that don't fit are counted in its
+ *     overflow counter
+ *   - UART transmit is interrupt driven with PINKIE_CFG_UART_TX_LEN bytes
+ *     buffer. If the buffer is full, the character waits for free space or
+ *     is dropped if the drop flag is set. With interrupts disabled, the
+ *     buffer is drained by polling.
  *
  * Copyright (c) 2017, Sven Bachmann <dev@mcbachmann.de>
  *
  * Licensed under the MIT license, see LICENSE for details.
  */
 #include <pinkie.h>
+#include <pinkie_ring.h>
 #include <avr/interrupt.h>
 
 
@@ -20,15 +27,33 @@
 /* http://www.nongnu.org/avr-libc/user-manual/FAQ.html#faq_wrong_baud_rate */
 #define UBRR_VAL ((F_CPU + BAUD * 8L) / (BAUD * 16L) - 1)
 
-#define PINKIE_ARCH_UART_BUF_SIZE           50  /**< UART ringbuffer size */
+#define PINKIE_ARCH_UART_RX_LEN             64  /**< UART receive ringbuffer size */
+
+
+/*****************************************************************************/
+/* Local prototypes */
+/*****************************************************************************/
+#if PINKIE_CFG_UART_TX_LEN
+static void pinkie_arch_uart_tx(
+    char c
+);
+#endif
+
+
+/*****************************************************************************/
+/* Variables */
+/*****************************************************************************/
+PINKIE_ARCH_UART_REG_T pinkie_arch_uart_reg;    /**< UART statistics */
 
 
 /*****************************************************************************/
 /* Local variables */
 /*****************************************************************************/
-static char rb_uart[PINKIE_ARCH_UART_BUF_SIZE]; /**< UART ringbuffer */
-static uint8_t volatile rb_uart_rd = 0;         /**< UART read index */
-static uint8_t volatile rb_uart_wr = 1;         /**< UART write index */
+PINKIE_RING_DEF(rb_uart, PINKIE_ARCH_UART_RX_LEN); /**< UART receive ringbuffer */
+
+#if PINKIE_CFG_UART_TX_LEN
+PINKIE_RING_DEF(rb_uart_tx, PINKIE_CFG_UART_TX_LEN); /**< UART transmit ringbuffer */
+#endif
 
 
 /*****************************************************************************/
@@ -50,6 +75,87 @@ int pinkie_stdio_init(
 }
 
 
+#if PINKIE_CFG_UART_TX_LEN
+/*****************************************************************************/
+/** PINKIE UART Transmit Character
+ *
+ * Queues a character for the UDRE interrupt.
+ */
+static void pinkie_arch_uart_tx(
+    char c
+)
+{
+    uint8_t fill;                               /* buffer fill level */
+    uint8_t old;                                /* oldest character */
+
+    if (PINKIE_CFG_UART_TX_LEN == pinkie_ring_fill(&rb_uart_tx)) {
+        pinkie_arch_uart_reg.cnt_full++;
+
+        /* the interrupt can't drain the buffer, so send the oldest character */
+        if (!(SREG & (1 << SREG_I))) {
+            pinkie_ring_get(&rb_uart_tx, &old);
+            while (!(UCSR0A & (1 << UDRE0)));
+            UDR0 = old;
+        }
+        else if (pinkie_arch_uart_reg.flg_drop) {
+            pinkie_arch_uart_reg.cnt_drop++;
+            return;
+        }
+        else {
+            while (PINKIE_CFG_UART_TX_LEN == pinkie_ring_fill(&rb_uart_tx));
+        }
+    }
+
+    pinkie_ring_put(&rb_uart_tx, (uint8_t) c);
+
+    fill = (uint8_t) pinkie_ring_fill(&rb_uart_tx);
+    if (fill > pinkie_arch_uart_reg.fill_max) {
+        pinkie_arch_uart_reg.fill_max = fill;
+    }
+
+    /* start transmission */
+    UCSR0B |= (1 << UDRIE0);
+}
+
+
+/*****************************************************************************/
+/** PINKIE UART Transmit ISR
+ */
+ISR(USART_UDRE_vect)
+{
+    uint8_t c;                                  /* character */
+
+    /* a late enable can raise the interrupt on an empty buffer */
+    if (!pinkie_ring_get(&rb_uart_tx, &c)) {
+        UCSR0B &= ~(1 << UDRIE0);
+        return;
+    }
+
+    UDR0 = c;
+
+    if (!pinkie_ring_fill(&rb_uart_tx)) {
+        UCSR0B &= ~(1 << UDRIE0);
+    }
+}
+
+
+/*****************************************************************************/
+/** PINKIE STDIO Put Character
+ *
+ * Writes a character to the standard output. This function only blocks if
+ * the transmit buffer is full.
+ */
+void pinkie_stdio_putc(
+    char c
+)
+{
+    if ('\n' == c) {
+        pinkie_arch_uart_tx('\r');
+    }
+
+    pinkie_arch_uart_tx(c);
+}
+#else
 /*****************************************************************************/
 /** PINKIE STDIO Put Character
  *
@@ -68,6 +174,7 @@ void pinkie_stdio_putc(
     while (!(UCSR0A & (1 << UDRE0)));
     UDR0 = c;
 }
+#endif
 
 
 /*****************************************************************************/
@@ -79,12 +186,7 @@ int pinkie_stdio_avail(
     void
 )
 {
-    /* check for empty ringbuffer */
-    if (((rb_uart_rd + 1) % PINKIE_ARCH_UART_BUF_SIZE) == rb_uart_wr) {
-        return 0;
-    }
-
-    return 1;
+    return !!pinkie_ring_fill(&rb_uart);
 }
 
 
@@ -93,9 +195,9 @@ int pinkie_stdio_avail(
  */
 ISR(USART_RX_vect)
 {
-    if (rb_uart_wr != rb_uart_rd) {
-        rb_uart[rb_uart_wr++] = UDR0;
-        rb_uart_wr %= PINKIE_ARCH_UART_BUF_SIZE;
+    /* always read the data register, otherwise the interrupt stays pending */
+    if (!pinkie_ring_put(&rb_uart, UDR0)) {
+        pinkie_arch_uart_reg.cnt_rx_ovf = rb_uart.cnt_ovf;
     }
 }
 
@@ -110,16 +212,11 @@ char pinkie_stdio_getc(
     void
 )
 {
-    uint8_t rd;
-
-    do {
-        rd = (rb_uart_rd + 1) % PINKIE_ARCH_UART_BUF_SIZE;
-    } while (rd == rb_uart_wr);
+    uint8_t c;                                  /* character */
 
-    /* return character */
-    rb_uart_rd = rd;
+    while (!pinkie_ring_get(&rb_uart, &c));
 
-    return rb_uart[rb_uart_rd];
+    return (char) c;
 }
 
 
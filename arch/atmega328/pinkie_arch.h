@@ -9,15 +9,32 @@
 #define PINKIE_ARCH_H
 
 #include <pinkie.h>
+#include <avr/pgmspace.h>
 #include <drv/nvs/pinkie_nvs.h>
 #include <drv/spi/pinkie_spi.h>
 #include <drv/timer/pinkie_timer.h>
 
 
+/*****************************************************************************/
+/* Configuration */
+/*****************************************************************************/
+#ifndef PINKIE_CFG_UART_TX_LEN
+#  define PINKIE_CFG_UART_TX_LEN        64      /**< UART transmit buffer (0 = blocking) */
+#endif
+
+#if (PINKIE_CFG_UART_TX_LEN > 128) || (PINKIE_CFG_UART_TX_LEN & (PINKIE_CFG_UART_TX_LEN - 1))
+#  error "UART transmit buffer must be a power of two up to 128 bytes"
+#endif
+
+
 /*****************************************************************************/
 /* Defines */
 /*****************************************************************************/
 #define PINKIE_ARCH_ENDIAN_LITTLE       1
+#define PINKIE_ARCH_ROM                 PROGMEM
+#define PINKIE_ARCH_ROM_READ(dst, src, len) memcpy_P(dst, src, len)
+#define PINKIE_ARCH_RING_IDX_T          uint8_t /**< ring counters are accessed in one instruction */
+#define PINKIE_ARCH_RING_SINGLE_CORE    1
 #define pinkie_stdio_exit()
 
 #ifndef PRIu64
@@ -33,6 +50,32 @@
 #endif
 
 
+#define PINKIE_ARCH_UART_REG_CNT_FULL   offsetof(PINKIE_ARCH_UART_REG_T, cnt_full)
+#define PINKIE_ARCH_UART_REG_CNT_DROP   offsetof(PINKIE_ARCH_UART_REG_T, cnt_drop)
+#define PINKIE_ARCH_UART_REG_FILL_MAX   offsetof(PINKIE_ARCH_UART_REG_T, fill_max)
+#define PINKIE_ARCH_UART_REG_FLG_DROP   offsetof(PINKIE_ARCH_UART_REG_T, flg_drop)
+#define PINKIE_ARCH_UART_REG_CNT_RX_OVF offsetof(PINKIE_ARCH_UART_REG_T, cnt_rx_ovf)
+
+
+/*****************************************************************************/
+/* Data types */
+/*****************************************************************************/
+/**< UART statistics RegReg mapping */
+typedef struct {
+    uint16_t cnt_full;                          /**< [rr:0-1] characters that found the buffer full */
+    uint16_t cnt_drop;                          /**< [rr:2-3] dropped characters */
+    uint8_t fill_max;                           /**< [rr:4] max buffer fill level */
+    uint8_t flg_drop;                           /**< [rr:5] drop instead of wait if full */
+    uint16_t cnt_rx_ovf;                        /**< [rr:6-7] received characters lost on full buffer */
+} __attribute__((packed)) PINKIE_ARCH_UART_REG_T;
+
+
+/*****************************************************************************/
+/* External variables */
+/*****************************************************************************/
+extern PINKIE_ARCH_UART_REG_T pinkie_arch_uart_reg; /**< UART statistics */
+
+
 /*****************************************************************************/
 /* Prototypes */
 /*****************************************************************************/
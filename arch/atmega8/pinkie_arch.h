@@ -9,6 +9,7 @@
 #define PINKIE_ARCH_H
 
 #include <pinkie.h>
+#include <avr/pgmspace.h>
 #include <drv/nvs/pinkie_nvs.h>
 #include <drv/spi/pinkie_spi.h>
 
@@ -17,6 +18,10 @@
 /* Defines */
 /*****************************************************************************/
 #define PINKIE_ARCH_ENDIAN_LITTLE       1
+#define PINKIE_ARCH_ROM                 PROGMEM
+#define PINKIE_ARCH_ROM_READ(dst, src, len) memcpy_P(dst, src, len)
+#define PINKIE_ARCH_RING_IDX_T          uint8_t /**< ring counters are accessed in one instruction */
+#define PINKIE_ARCH_RING_SINGLE_CORE    1
 #define pinkie_stdio_exit()
 #define pinkie_arch_init_fin()
 
@@ -5,6 +5,7 @@
  *
  * Licensed under the MIT license, see LICENSE for details.
  */
+#define _POSIX_C_SOURCE 199309L
 #include <pinkie.h>
 #include <errno.h>
 #include <string.h>
@@ -13,6 +14,7 @@
 #include <termios.h>
 #include <unistd.h>
 #include <inttypes.h>
+#include <time.h>
 
 
 /*****************************************************************************/
@@ -76,3 +78,20 @@ int pinkie_stdio_exit(
 
     return 0;
 }
+
+
+/*****************************************************************************/
+/** Monotonic clock in microseconds
+ *
+ * Finer than the millisecond timer, used to measure short durations.
+ */
+uint64_t pinkie_arch_time_us(
+    void
+)
+{
+    struct timespec ts;                         /* timestamp */
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t) ts.tv_sec * 1000000) + ((uint64_t) ts.tv_nsec / 1000);
+}
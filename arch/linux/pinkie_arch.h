@@ -8,6 +8,7 @@
 #ifndef PINKIE_ARCH_H
 #define PINKIE_ARCH_H
 
+#include <stdint.h>
 #include <stdio.h>
 
 
@@ -22,9 +23,19 @@
 
 #define pinkie_stdio_getc               getchar
 #define pinkie_stdio_putc               putchar
+#define pinkie_stdio_write(data, len)   ((void) fwrite(data, 1, len, stdout))
 #define pinkie_stdio_getc               getchar
 #define pinkie_stdio_avail()            (!feof(stdin))
 #define pinkie_arch_init_fin()
+#define PINKIE_ARCH_TIME_US()           pinkie_arch_time_us() /**< microsecond time source */
+
+
+/*****************************************************************************/
+/* Prototypes */
+/*****************************************************************************/
+uint64_t pinkie_arch_time_us(
+    void
+);
 
 
 #endif /* PINKIE_ARCH_H */
@@ -43,6 +43,14 @@ typedef int PINKIE_RES_T;                       /**< PINKIE result */
 #define PINKIE_UNUSED(x)            (void)(x)
 #define PINKIE_ARRAY_COUNT(x)       (sizeof(x) / sizeof(x[0]))
 
+#ifndef PINKIE_ARCH_ROM
+#  define PINKIE_ARCH_ROM
+#endif
+
+#ifndef PINKIE_ARCH_ROM_READ
+#  define PINKIE_ARCH_ROM_READ(dst, src, len)   memcpy(dst, src, len)
+#endif
+
 #ifdef PINKIE_ARCH_ENDIAN_LITTLE
 #  define PINKIE_HTOBE16(x)         pinkie_swap16_ua((uint8_t *) &x)
 #  define PINKIE_BE16TOH(x)         pinkie_swap16_ua((uint8_t *) &x)
@@ -0,0 +1,200 @@
+/**
+ * @brief PINKIE - Single Producer Single Consumer Ring
+ *
+ * Byte ring for exactly one producer and one consumer, e.g. main loop and
+ * interrupt or two threads. No locks are required: the read counter is only
+ * written by the consumer, the write counter only by the producer.
+ *
+ * Both counters run freely and are masked on buffer access, so the full size
+ * is usable and the fill level is the counter difference. Therefore the size
+ * must be a power of two and at most half of the index range.
+ *
+ * A counter is published after the data was copied and the other counter is
+ * read before touching the data. On Linux this is done with acquire/release
+ * atomics. Architectures with PINKIE_ARCH_RING_SINGLE_CORE set access their
+ * counters in one instruction, there only the compiler must keep the order.
+ *
+ * Functions:
+ *   - pinkie_ring_put: producer, add one byte
+ *   - pinkie_ring_get: consumer, take one byte
+ *   - pinkie_ring_push: producer, add as many bytes as fit
+ *   - pinkie_ring_pop: consumer, take up to the given count of bytes
+ *   - pinkie_ring_fill: both, get the fill level
+ *
+ * Bytes that don't fit are counted in cnt_ovf.
+ *
+ * Copyright (c) 2017, Sven Bachmann <dev@mcbachmann.de>
+ *
+ * Licensed under the MIT license, see LICENSE for details.
+ */
+#include <pinkie.h>
+#include "pinkie_ring.h"
+
+
+/*****************************************************************************/
+/* Local defines */
+/*****************************************************************************/
+#if PINKIE_ARCH_RING_SINGLE_CORE == 1
+#  define PINKIE_RING_LOAD(idx)         (*(volatile PINKIE_RING_IDX_T *) &(idx))
+#  define PINKIE_RING_STORE(idx, val)   (*(volatile PINKIE_RING_IDX_T *) &(idx) = (val))
+#  define PINKIE_RING_FENCE()           __asm__ __volatile__ ("" ::: "memory")
+#else
+#  define PINKIE_RING_LOAD(idx)         __atomic_load_n(&(idx), __ATOMIC_ACQUIRE)
+#  define PINKIE_RING_STORE(idx, val)   __atomic_store_n(&(idx), (val), __ATOMIC_RELEASE)
+#  define PINKIE_RING_FENCE()
+#endif
+
+
+/*****************************************************************************/
+/** Add one byte
+ *
+ * @returns 1 on success, 0 if the ring is full
+ */
+unsigned int pinkie_ring_put(
+    PINKIE_RING_T *ring,                        /**< ring */
+    uint8_t val                                 /**< byte */
+)
+{
+    PINKIE_RING_IDX_T rd;                       /* read counter */
+    PINKIE_RING_IDX_T wr = ring->wr;            /* write counter */
+
+    rd = PINKIE_RING_LOAD(ring->rd);
+    PINKIE_RING_FENCE();
+
+    if ((PINKIE_RING_IDX_T) (wr - rd) > ring->mask) {
+        ring->cnt_ovf++;
+        return 0;
+    }
+
+    ring->buf[wr & ring->mask] = val;
+
+    PINKIE_RING_FENCE();
+    PINKIE_RING_STORE(ring->wr, (PINKIE_RING_IDX_T) (wr + 1));
+
+    return 1;
+}
+
+
+/*****************************************************************************/
+/** Take one byte
+ *
+ * @returns 1 on success, 0 if the ring is empty
+ */
+unsigned int pinkie_ring_get(
+    PINKIE_RING_T *ring,                        /**< ring */
+    uint8_t *val                                /**< byte */
+)
+{
+    PINKIE_RING_IDX_T rd = ring->rd;            /* read counter */
+    PINKIE_RING_IDX_T wr;                       /* write counter */
+
+    wr = PINKIE_RING_LOAD(ring->wr);
+    PINKIE_RING_FENCE();
+
+    if (rd == wr) {
+        return 0;
+    }
+
+    *val = ring->buf[rd & ring->mask];
+
+    PINKIE_RING_FENCE();
+    PINKIE_RING_STORE(ring->rd, (PINKIE_RING_IDX_T) (rd + 1));
+
+    return 1;
+}
+
+
+/*****************************************************************************/
+/** Add as many bytes as fit
+ *
+ * The data is copied in at most two parts, before and after the buffer end.
+ *
+ * @returns count of added bytes
+ */
+unsigned int pinkie_ring_push(
+    PINKIE_RING_T *ring,                        /**< ring */
+    const uint8_t *data,                        /**< data */
+    unsigned int len                            /**< data length */
+)
+{
+    PINKIE_RING_IDX_T rd;                       /* read counter */
+    PINKIE_RING_IDX_T wr = ring->wr;            /* write counter */
+    unsigned int pos = wr & ring->mask;         /* buffer position */
+    unsigned int space;                         /* free space */
+    unsigned int part;                          /* length up to buffer end */
+
+    rd = PINKIE_RING_LOAD(ring->rd);
+    PINKIE_RING_FENCE();
+
+    space = (unsigned int) ring->mask + 1 - (PINKIE_RING_IDX_T) (wr - rd);
+    if (len > space) {
+        ring->cnt_ovf += (uint16_t) (len - space);
+        len = space;
+    }
+
+    part = (unsigned int) ring->mask + 1 - pos;
+    if (part > len) {
+        part = len;
+    }
+
+    memcpy(&ring->buf[pos], data, part);
+    memcpy(ring->buf, &data[part], len - part);
+
+    PINKIE_RING_FENCE();
+    PINKIE_RING_STORE(ring->wr, (PINKIE_RING_IDX_T) (wr + len));
+
+    return len;
+}
+
+
+/*****************************************************************************/
+/** Take up to the given count of bytes
+ *
+ * @returns count of taken bytes
+ */
+unsigned int pinkie_ring_pop(
+    PINKIE_RING_T *ring,                        /**< ring */
+    uint8_t *data,                              /**< data buffer */
+    unsigned int len                            /**< buffer length */
+)
+{
+    PINKIE_RING_IDX_T rd = ring->rd;            /* read counter */
+    PINKIE_RING_IDX_T wr;                       /* write counter */
+    unsigned int pos = rd & ring->mask;         /* buffer position */
+    unsigned int fill;                          /* fill level */
+    unsigned int part;                          /* length up to buffer end */
+
+    wr = PINKIE_RING_LOAD(ring->wr);
+    PINKIE_RING_FENCE();
+
+    fill = (PINKIE_RING_IDX_T) (wr - rd);
+    if (len > fill) {
+        len = fill;
+    }
+
+    part = (unsigned int) ring->mask + 1 - pos;
+    if (part > len) {
+        part = len;
+    }
+
+    memcpy(data, &ring->buf[pos], part);
+    memcpy(&data[part], ring->buf, len - part);
+
+    PINKIE_RING_FENCE();
+    PINKIE_RING_STORE(ring->rd, (PINKIE_RING_IDX_T) (rd + len));
+
+    return len;
+}
+
+
+/*****************************************************************************/
+/** Get fill level
+ *
+ * Called from the other side, the level can already be outdated.
+ */
+unsigned int pinkie_ring_fill(
+    PINKIE_RING_T *ring                         /**< ring */
+)
+{
+    return (PINKIE_RING_IDX_T) (PINKIE_RING_LOAD(ring->wr) - PINKIE_RING_LOAD(ring->rd));
+}
@@ -0,0 +1,80 @@
+/**
+ * @brief PINKIE - Single Producer Single Consumer Ring
+ *
+ * Copyright (c) 2017, Sven Bachmann <dev@mcbachmann.de>
+ *
+ * Licensed under the MIT license, see LICENSE for details.
+ */
+#ifndef PINKIE_RING_H
+#define PINKIE_RING_H
+
+#include <pinkie.h>
+
+
+/*****************************************************************************/
+/* Defines */
+/*****************************************************************************/
+#ifndef PINKIE_ARCH_RING_IDX_T
+#  define PINKIE_ARCH_RING_IDX_T        unsigned int
+#endif
+
+/**< max ring size, half of the index range to tell full and empty apart */
+#define PINKIE_RING_SIZE_MAX            (((PINKIE_RING_IDX_T) -1 / 2) + 1)
+
+
+/**< define a ring with a static buffer
+ *
+ * The size must be a power of two up to PINKIE_RING_SIZE_MAX, otherwise the
+ * size check array gets a negative size.
+ */
+#define PINKIE_RING_DEF(name, size) \
+    typedef char name##_size_chk[(((size) & ((size) - 1)) || ((size) > PINKIE_RING_SIZE_MAX)) ? -1 : 1]; \
+    static uint8_t name##_buf[size]; \
+    static PINKIE_RING_T name = { name##_buf, (size) - 1, 0, 0, 0 }
+
+
+/*****************************************************************************/
+/* Data types */
+/*****************************************************************************/
+typedef PINKIE_ARCH_RING_IDX_T PINKIE_RING_IDX_T; /**< ring index */
+
+typedef struct {
+    uint8_t *buf;                               /**< buffer */
+    PINKIE_RING_IDX_T mask;                     /**< buffer size - 1 */
+    PINKIE_RING_IDX_T rd;                       /**< read counter, only written by consumer */
+    PINKIE_RING_IDX_T wr;                       /**< write counter, only written by producer */
+    uint16_t cnt_ovf;                           /**< rejected bytes, only written by producer */
+} PINKIE_RING_T;
+
+
+/*****************************************************************************/
+/* Prototypes */
+/*****************************************************************************/
+unsigned int pinkie_ring_put(
+    PINKIE_RING_T *ring,                        /**< ring */
+    uint8_t val                                 /**< byte */
+);
+
+unsigned int pinkie_ring_get(
+    PINKIE_RING_T *ring,                        /**< ring */
+    uint8_t *val                                /**< byte */
+);
+
+unsigned int pinkie_ring_push(
+    PINKIE_RING_T *ring,                        /**< ring */
+    const uint8_t *data,                        /**< data */
+    unsigned int len                            /**< data length */
+);
+
+unsigned int pinkie_ring_pop(
+    PINKIE_RING_T *ring,                        /**< ring */
+    uint8_t *data,                              /**< data buffer */
+    unsigned int len                            /**< buffer length */
+);
+
+unsigned int pinkie_ring_fill(
+    PINKIE_RING_T *ring                         /**< ring */
+);
+
+
+#endif /* PINKIE_RING_H */
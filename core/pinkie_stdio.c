@@ -3,10 +3,19 @@
  *
  * Provides functions:
  *   pinkie_i2s - integer to string
- *   pinkie_s2i - string to integer
  *   pinkie_c2i - character to integer
  *   pinkie_printf - printf
+ *   pinkie_printf_fmt - printf with precompiled format
+ *   pinkie_snprintf - snprintf
+ *   pinkie_vprintf_sink - vprintf to output sink
+ *   pinkie_vprintf_fmt_sink - vprintf with precompiled format to output sink
  *   pinkie_sscanf - sscanf
+ *   pinkie_scan_int - bounded string to integer with range check
+ *   pinkie_scan_bytes - bounded byte list or quoted string to buffer
+ *
+ * Formatted output is emitted through an output sink. Literal text, strings
+ * and converted integers are passed as blocks, so sinks with a block write
+ * don't need a call per character.
  *
  * Most functions work from 8 to 64 bit.
  *
@@ -20,14 +29,345 @@
 
 
 /*****************************************************************************/
-/** Integer To String
+/* Local defines */
+/*****************************************************************************/
+#define PINKIE_I2S_BUF_LEN              (PINKIE_CFG_PRINTF_MAX_INT * 8) /**< binary digits of max int */
+#define PINKIE_I2S_DEC_CHUNK            100000000UL /**< 8 decimal digits */
+#define PINKIE_I2S_DEC_CHUNK_LEN        8       /**< decimal chunk digits */
+#define PINKIE_FMT_BUF_LEN              32      /**< precompiled format line buffer */
+#define PINKIE_FMT_NUM_LEN              (((PINKIE_CFG_PRINTF_MAX_INT * 8) + 2) / 3) /**< octal digits of max int, fits decimal and hex */
+#define PINKIE_SCAN_DEC_SAFE            ((PINKIE_CFG_SSCANF_MAX_INT * 8 * 3) / 10) /**< decimal digits without overflow */
+
+
+/*****************************************************************************/
+/* Local datatypes */
+/*****************************************************************************/
+#if PINKIE_CFG_PRINTF_MAX_INT >= 4
+typedef uint32_t PINKIE_I2S_DEC_T;              /**< decimal conversion type */
+#else
+typedef PINKIE_PRINTF_UINT_T PINKIE_I2S_DEC_T;  /**< decimal conversion type */
+#endif
+
+
+/*****************************************************************************/
+/* Local prototypes */
+/*****************************************************************************/
+static char * pinkie_i2s_dec(
+    PINKIE_I2S_DEC_T num,                       /**< unsigned integer */
+    char *pos,                                  /**< buffer end */
+    unsigned int cnt_min                        /**< minimum digit count */
+);
+
+static char * pinkie_i2s_rev(
+    PINKIE_PRINTF_UINT_T num,                   /**< unsigned integer */
+    unsigned int base,                          /**< base */
+    char *pos                                   /**< buffer end */
+);
+
+static unsigned int pinkie_fmt_buf_write(
+    PINKIE_SINK_T *sink,                        /**< sink */
+    char *buf,                                  /**< line buffer */
+    unsigned int pos,                           /**< line buffer fill level */
+    const char *data,                           /**< data */
+    unsigned int len                            /**< data length */
+);
+
+static void pinkie_sink_stdio_put(
+    PINKIE_SINK_T *sink,                        /**< sink */
+    char chr                                    /**< character */
+);
+
+#ifdef pinkie_stdio_write
+static void pinkie_sink_stdio_write(
+    PINKIE_SINK_T *sink,                        /**< sink */
+    const char *data,                           /**< data */
+    unsigned int len                            /**< data length */
+);
+#endif
+
+static void pinkie_sink_buf_put(
+    PINKIE_SINK_T *sink,                        /**< sink */
+    char chr                                    /**< character */
+);
+
+static void pinkie_sink_buf_write(
+    PINKIE_SINK_T *sink,                        /**< sink */
+    const char *data,                           /**< data */
+    unsigned int len                            /**< data length */
+);
+
+
+/*****************************************************************************/
+/* Variables */
+/*****************************************************************************/
+PINKIE_SINK_T pinkie_sink_stdio = {             /**< sink to pinkie_stdio_putc */
+    pinkie_sink_stdio_put,
+#ifdef pinkie_stdio_write
+    pinkie_sink_stdio_write,
+#else
+    NULL,
+#endif
+};
+
+
+/*****************************************************************************/
+/* Local variables */
+/*****************************************************************************/
+static const char pinkie_i2s_pairs[201] PINKIE_ARCH_ROM = /**< decimal digit pairs */
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+
+/*****************************************************************************/
+/** Put character to sink
+ */
+void pinkie_sink_put(
+    PINKIE_SINK_T *sink,                        /**< sink */
+    char chr                                    /**< character */
+)
+{
+    sink->put(sink, chr);
+}
+
+
+/*****************************************************************************/
+/** Write block to sink
+ *
+ * Sinks without block write get each character separately.
+ */
+void pinkie_sink_write(
+    PINKIE_SINK_T *sink,                        /**< sink */
+    const char *data,                           /**< data */
+    unsigned int len                            /**< data length */
+)
+{
+    if (sink->write) {
+        sink->write(sink, data, len);
+        return;
+    }
+
+    for (; len; len--) {
+        sink->put(sink, *data++);
+    }
+}
+
+
+/*****************************************************************************/
+/** Standard output sink: put character
+ */
+static void pinkie_sink_stdio_put(
+    PINKIE_SINK_T *sink,                        /**< sink */
+    char chr                                    /**< character */
+)
+{
+    PINKIE_UNUSED(sink);
+
+    pinkie_stdio_putc(chr);
+}
+
+
+#ifdef pinkie_stdio_write
+/*****************************************************************************/
+/** Standard output sink: write block
+ */
+static void pinkie_sink_stdio_write(
+    PINKIE_SINK_T *sink,                        /**< sink */
+    const char *data,                           /**< data */
+    unsigned int len                            /**< data length */
+)
+{
+    PINKIE_UNUSED(sink);
+
+    pinkie_stdio_write(data, len);
+}
+#endif
+
+
+/*****************************************************************************/
+/** Buffer Sink Initialization
+ */
+void pinkie_sink_buf_init(
+    PINKIE_SINK_BUF_T *sbuf,                    /**< buffer sink */
+    char *buf,                                  /**< buffer */
+    unsigned int len,                           /**< buffer size */
+    PINKIE_SINK_T *next                         /**< flush target or NULL to truncate */
+)
+{
+    sbuf->sink.put = pinkie_sink_buf_put;
+    sbuf->sink.write = pinkie_sink_buf_write;
+    sbuf->next = next;
+    sbuf->buf = buf;
+    sbuf->len = len;
+    sbuf->pos = 0;
+    sbuf->cnt = 0;
+
+    /* keep room for string termination when truncating */
+    if ((!next) && (len)) {
+        sbuf->len--;
+    }
+}
+
+
+/*****************************************************************************/
+/** Flush buffer sink to its next sink
+ */
+void pinkie_sink_buf_flush(
+    PINKIE_SINK_BUF_T *sbuf                     /**< buffer sink */
+)
+{
+    if ((sbuf->next) && (sbuf->pos)) {
+        pinkie_sink_write(sbuf->next, sbuf->buf, sbuf->pos);
+        sbuf->pos = 0;
+    }
+}
+
+
+/*****************************************************************************/
+/** Buffer sink: put character
+ */
+static void pinkie_sink_buf_put(
+    PINKIE_SINK_T *sink,                        /**< sink */
+    char chr                                    /**< character */
+)
+{
+    pinkie_sink_buf_write(sink, &chr, 1);
+}
+
+
+/*****************************************************************************/
+/** Buffer sink: write block
+ */
+static void pinkie_sink_buf_write(
+    PINKIE_SINK_T *sink,                        /**< sink */
+    const char *data,                           /**< data */
+    unsigned int len                            /**< data length */
+)
+{
+    PINKIE_SINK_BUF_T *sbuf = (PINKIE_SINK_BUF_T *) sink; /* buffer sink */
+    unsigned int cnt;                           /* block length */
+
+    sbuf->cnt += len;
+
+    while (len) {
+        if (sbuf->pos == sbuf->len) {
+            if (!sbuf->next) {
+                return;
+            }
+            pinkie_sink_buf_flush(sbuf);
+
+            /* pass blocks that don't fit into an empty buffer */
+            if (len >= sbuf->len) {
+                pinkie_sink_write(sbuf->next, data, len);
+                return;
+            }
+        }
+
+        cnt = sbuf->len - sbuf->pos;
+        if (cnt > len) {
+            cnt = len;
+        }
+
+        memcpy(&sbuf->buf[sbuf->pos], data, cnt);
+        sbuf->pos += cnt;
+        data += cnt;
+        len -= cnt;
+    }
+}
+
+
+/*****************************************************************************/
+/** Decimal To String
+ *
+ * Writes the digits backwards in front of the given buffer end, two digits
+ * per division. Zeros are prepended up to the minimum digit count.
+ *
+ * @returns first digit position
+ */
+static char * pinkie_i2s_dec(
+    PINKIE_I2S_DEC_T num,                       /**< unsigned integer */
+    char *pos,                                  /**< buffer end */
+    unsigned int cnt_min                        /**< minimum digit count */
+)
+{
+    char *end = pos;                            /* buffer end */
+    PINKIE_I2S_DEC_T quot;                      /* quotient */
+
+    for (; num >= 100; num = quot) {
+        quot = num / 100;
+        pos -= 2;
+        PINKIE_ARCH_ROM_READ(pos, &pinkie_i2s_pairs[(num - (quot * 100)) * 2], 2);
+    }
+
+    if (num >= 10) {
+        pos -= 2;
+        PINKIE_ARCH_ROM_READ(pos, &pinkie_i2s_pairs[num * 2], 2);
+    }
+    else if (num) {
+        *--pos = '0' + num;
+    }
+
+    while ((unsigned int) (end - pos) < cnt_min) {
+        *--pos = '0';
+    }
+
+    return pos;
+}
+
+
+/*****************************************************************************/
+/** Integer To Reverse Buffer
+ *
+ * Base 10 converts two digits per division and splits 64 bit numbers into 32
+ * bit chunks, base 16 only shifts and masks. The buffer must fit the octal
+ * representation of the largest printf integer.
  *
- * This function doesn't need an extra buffer to store the string-converted
- * integer but uses a lot of CPU power. It is a compromise because I didn't
- * found a header that contains the actual count of characters that is needed
- * to represent the architecture specific integer as string. I didn't want a
- * catch-all solution that uses the same amount of reserved bytes for an 8-bit
- * system that is needed for an 64-bit integer.
+ * @returns first digit position
+ */
+static char * pinkie_i2s_rev(
+    PINKIE_PRINTF_UINT_T num,                   /**< unsigned integer */
+    unsigned int base,                          /**< base */
+    char *pos                                   /**< buffer end */
+)
+{
+    unsigned int digit;                         /* current digit */
+
+    if (10 == base) {
+#if PINKIE_CFG_PRINTF_MAX_INT >= 8
+        for (; num > UINT32_MAX; num /= PINKIE_I2S_DEC_CHUNK) {
+            pos = pinkie_i2s_dec((PINKIE_I2S_DEC_T) (num % PINKIE_I2S_DEC_CHUNK), pos, PINKIE_I2S_DEC_CHUNK_LEN);
+        }
+#endif
+        return pinkie_i2s_dec((PINKIE_I2S_DEC_T) num, pos, 0);
+    }
+
+    if (16 == base) {
+        for (; num; num >>= 4) {
+            digit = num & 0xf;
+            *--pos = digit + ((digit < 10) ? '0' : ('a' - 10));
+        }
+
+        return pos;
+    }
+
+    for (; num; num /= base) {
+        digit = num % base;
+        *--pos = digit + ((digit < 10) ? '0' : ('a' - 10));
+    }
+
+    return pos;
+}
+
+
+/*****************************************************************************/
+/** Integer To String
  */
 void pinkie_i2s(
     PINKIE_PRINTF_UINT_T num,                   /**< unsigned integer */
@@ -36,43 +376,59 @@ void pinkie_i2s(
     uint8_t cnt_pad                             /**< pad count */
 )
 {
-    PINKIE_PRINTF_UINT_T num_temp;              /* temporary number buffer */
-    unsigned int digit;                         /* found digit */
-    unsigned int digits = 0;                    /* digits found */
-    unsigned int digit_cnt;                     /* digit counter */
+    pinkie_i2s_sink(&pinkie_sink_stdio, num, base, flg_zero, cnt_pad);
+}
+
+
+/*****************************************************************************/
+/** Integer To String Sink
+ *
+ * Converts the number in a single pass into a reverse buffer that fits the
+ * binary representation of the largest printf integer, so all bases from 2 to
+ * 36 are supported.
+ *
+ * Zero has no digits, so it is printed by the padding.
+ */
+void pinkie_i2s_sink(
+    PINKIE_SINK_T *sink,                        /**< sink */
+    PINKIE_PRINTF_UINT_T num,                   /**< unsigned integer */
+    unsigned int base,                          /**< base */
+    uint8_t flg_zero,                           /**< prefix with zero */
+    uint8_t cnt_pad                             /**< pad count */
+)
+{
+    char buf[PINKIE_I2S_BUF_LEN];               /* reverse digit buffer */
+    char *pos;                                  /* first digit */
+    unsigned int digits;                        /* digit count */
     uint8_t pad;                                /* pad character */
 
-    /* count digits */
-    for (num_temp = num; num_temp; digit = num_temp % base, num_temp /= base, digits++);
+    pos = pinkie_i2s_rev(num, base, &buf[sizeof(buf)]);
+    digits = &buf[sizeof(buf)] - pos;
 
     /* check if padding is needed */
     if (cnt_pad > digits) {
         pad = ((flg_zero) || (!digits)) ? '0' : ' ';
         for (cnt_pad -= digits; cnt_pad; cnt_pad--) {
-            pinkie_stdio_putc(pad);
+            sink->put(sink, pad);
         }
     }
 
-    for (; digits; digits--) {
-        for (num_temp = num, digit_cnt = digits; digit_cnt; digit_cnt--, digit = num_temp % base, num_temp /= base);
-
-        pinkie_stdio_putc(digit + ((digit < 10) ? '0' : ('a' - 10)));
-    }
+    pinkie_sink_write(sink, pos, digits);
 }
 
 
-#ifndef pinkie_printf
 /*****************************************************************************/
-/** PINKIE Just Enough Printf To Work
+/** PINKIE Just Enough Printf To Work - Sink Output
  */
-void pinkie_printf(
+void pinkie_vprintf_sink(
+    PINKIE_SINK_T *sink,                        /**< sink */
     const char *fmt,                            /**< format string */
-    ...                                         /**< variable arguments */
+    va_list ap                                  /**< variable argument list */
 )
 {
-    va_list ap;                                 /* variable argument list */
     unsigned int flg_format = 0;                /* format flag */
-    char *sub;                                  /* sub string */
+    const char *sub;                            /* sub string */
+    unsigned int len;                           /* sub string length */
     uint8_t cnt_pad = 1;                        /* pad count */
     uint8_t flg_zero = 0;                       /* prefix with zero */
     uint8_t flg_precision = 0;                  /* precision flag */
@@ -82,7 +438,6 @@ void pinkie_printf(
     PINKIE_PRINTF_UINT_T val = 0;               /* unsigned value */
     unsigned int int_width = 0;                 /* integer width */
 
-    va_start(ap, fmt);
     for (; *fmt; fmt++) {
 
         if (flg_format) {
@@ -123,26 +478,26 @@ void pinkie_printf(
 
             switch (*fmt) {
                 case '%':
-                    pinkie_stdio_putc('%');
+                    sink->put(sink, '%');
                     break;
 
                 case 's':
-                    for (sub = va_arg(ap, char *); (precision--) && (*sub); sub++) {
-                        pinkie_stdio_putc(*sub);
-                    }
+                    sub = va_arg(ap, const char *);
+                    for (len = 0; (precision--) && (sub[len]); len++);
+                    pinkie_sink_write(sink, sub, len);
                     break;
 
                 case 'c':
-                    pinkie_stdio_putc((char) va_arg(ap, int));
+                    sink->put(sink, (char) va_arg(ap, int));
                     break;
 
                 case 'i':
                     val_int = va_arg(ap, int);
                     if (0 > val_int) {
-                        pinkie_stdio_putc('-');
+                        sink->put(sink, '-');
                         val_int = -val_int;
                     }
-                    pinkie_i2s(val_int, 10, flg_zero, cnt_pad);
+                    pinkie_i2s_sink(sink, val_int, 10, flg_zero, cnt_pad);
                     break;
 
                 case 'u':                       /* unsigned int */
@@ -177,7 +532,7 @@ void pinkie_printf(
                     val = val & 0xff;
                 }
 
-                pinkie_i2s(val, base, flg_zero, cnt_pad);
+                pinkie_i2s_sink(sink, val, base, flg_zero, cnt_pad);
                 base = 0;
                 int_width = 0;
             }
@@ -196,20 +551,264 @@ void pinkie_printf(
             continue;
         }
 
-        pinkie_stdio_putc(*fmt);
+        /* pass literal text up to the next format as one block */
+        for (sub = fmt; (fmt[1]) && ('%' != fmt[1]); fmt++);
+        pinkie_sink_write(sink, sub, fmt - sub + 1);
     }
+}
+
+
+#ifndef pinkie_printf
+/*****************************************************************************/
+/** PINKIE Just Enough Printf To Work
+ *
+ * With PINKIE_CFG_PRINTF_BUF_LEN set, the output is collected on the stack
+ * and passed to standard output in blocks.
+ */
+void pinkie_printf(
+    const char *fmt,                            /**< format string */
+    ...                                         /**< variable arguments */
+)
+{
+    va_list ap;                                 /* variable argument list */
+#if PINKIE_CFG_PRINTF_BUF_LEN
+    char buf[PINKIE_CFG_PRINTF_BUF_LEN];        /* output buffer */
+    PINKIE_SINK_BUF_T sbuf;                     /* buffer sink */
+
+    pinkie_sink_buf_init(&sbuf, buf, sizeof(buf), &pinkie_sink_stdio);
+
+    va_start(ap, fmt);
+    pinkie_vprintf_sink(&sbuf.sink, fmt, ap);
+    va_end(ap);
+
+    pinkie_sink_buf_flush(&sbuf);
+#else
+    va_start(ap, fmt);
+    pinkie_vprintf_sink(&pinkie_sink_stdio, fmt, ap);
     va_end(ap);
+#endif
 }
 #endif /* pinkie_printf */
 
 
+/*****************************************************************************/
+/** Precompiled Format Line Buffer Write
+ *
+ * Flushes the line buffer to the sink if the data doesn't fit. Data larger
+ * than the buffer is passed directly.
+ *
+ * @returns new fill level
+ */
+static unsigned int pinkie_fmt_buf_write(
+    PINKIE_SINK_T *sink,                        /**< sink */
+    char *buf,                                  /**< line buffer */
+    unsigned int pos,                           /**< line buffer fill level */
+    const char *data,                           /**< data */
+    unsigned int len                            /**< data length */
+)
+{
+    if (len > (PINKIE_FMT_BUF_LEN - pos)) {
+        pinkie_sink_write(sink, buf, pos);
+        pos = 0;
+
+        if (len > PINKIE_FMT_BUF_LEN) {
+            pinkie_sink_write(sink, data, len);
+            return 0;
+        }
+    }
+
+    memcpy(&buf[pos], data, len);
+
+    return pos + len;
+}
+
+
+/*****************************************************************************/
+/** PINKIE Printf With Precompiled Format - Sink Output
+ *
+ * Produces the same output as pinkie_vprintf_sink for the equivalent format
+ * string, but signed values are read with their full width. Numbers are
+ * padded in the conversion buffer, so the pad count is limited to the octal
+ * digits of the largest printf integer. The output is collected in a small
+ * line buffer and passed to the sink in blocks.
+ */
+void pinkie_vprintf_fmt_sink(
+    PINKIE_SINK_T *sink,                        /**< sink */
+    const PINKIE_FMT_OP_T *op,                  /**< precompiled format */
+    va_list ap                                  /**< variable argument list */
+)
+{
+    char buf[PINKIE_FMT_BUF_LEN];               /* line buffer */
+    unsigned int pos = 0;                       /* line buffer fill level */
+    char num[PINKIE_FMT_NUM_LEN + 1];           /* sign and padded digits */
+    char *num_pos;                              /* first number character */
+    const char *sub;                            /* sub string */
+    unsigned int len;                           /* sub string length */
+    PINKIE_PRINTF_INT_T val_int;                /* signed value */
+    PINKIE_PRINTF_UINT_T val;                   /* unsigned value */
+    unsigned int flg_neg;                       /* negative flag */
+    unsigned int cnt_pad;                       /* pad count */
+    char chr;                                   /* character */
+
+    for (; PINKIE_FMT_CONV_END != op->conv; op++) {
+
+        flg_neg = 0;
+
+        switch (op->conv & PINKIE_FMT_CONV_MASK) {
+
+            case PINKIE_FMT_CONV_TEXT:
+                pos = pinkie_fmt_buf_write(sink, buf, pos, op->text, op->len);
+                continue;
+
+            case PINKIE_FMT_CONV_C:
+                chr = (char) va_arg(ap, int);
+                pos = pinkie_fmt_buf_write(sink, buf, pos, &chr, 1);
+                continue;
+
+            case PINKIE_FMT_CONV_S:
+                sub = va_arg(ap, const char *);
+                for (len = 0; sub[len]; len++);
+                pos = pinkie_fmt_buf_write(sink, buf, pos, sub, len);
+                continue;
+
+            case PINKIE_FMT_CONV_I:
+#if (PINKIE_CFG_PRINTF_MAX_INT >= 4) && (INT32_MAX != INT_MAX)
+                if (sizeof(int32_t) == op->len) {
+                    val_int = va_arg(ap, int32_t);
+                }
+                else
+#endif
+#if (PINKIE_CFG_PRINTF_MAX_INT >= 8) && (INT64_MAX != INT_MAX)
+                if (sizeof(int64_t) == op->len) {
+                    val_int = va_arg(ap, int64_t);
+                }
+                else
+#endif
+                val_int = va_arg(ap, int);
+
+                val = (PINKIE_PRINTF_UINT_T) val_int;
+                if (0 > val_int) {
+                    flg_neg = 1;
+                    val = -val;
+                }
+                break;
+
+            default:
+#if (PINKIE_CFG_PRINTF_MAX_INT >= 4) && (UINT32_MAX != UINT_MAX)
+                if (sizeof(uint32_t) == op->len) {
+                    val = va_arg(ap, uint32_t);
+                }
+                else
+#endif
+#if (PINKIE_CFG_PRINTF_MAX_INT >= 8) && (UINT64_MAX != UINT_MAX)
+                if (sizeof(uint64_t) == op->len) {
+                    val = va_arg(ap, uint64_t);
+                }
+                else
+#endif
+                val = va_arg(ap, unsigned int);
+
+                if (sizeof(uint16_t) == op->len) {
+                    val = val & 0xffff;
+                }
+                else if (sizeof(uint8_t) == op->len) {
+                    val = val & 0xff;
+                }
+        }
+
+        num_pos = pinkie_i2s_rev(val, (PINKIE_FMT_CONV_X == (op->conv & PINKIE_FMT_CONV_MASK)) ? 16 : 10, &num[sizeof(num)]);
+
+        /* zero has no digits, so it is printed by the padding */
+        chr = ((op->conv & PINKIE_FMT_ZERO) || (num_pos == &num[sizeof(num)])) ? '0' : ' ';
+        cnt_pad = (op->pad < PINKIE_FMT_NUM_LEN) ? op->pad : PINKIE_FMT_NUM_LEN;
+        while ((unsigned int) (&num[sizeof(num)] - num_pos) < cnt_pad) {
+            *--num_pos = chr;
+        }
+
+        if (flg_neg) {
+            *--num_pos = '-';
+        }
+
+        pos = pinkie_fmt_buf_write(sink, buf, pos, num_pos, &num[sizeof(num)] - num_pos);
+    }
+
+    if (pos) {
+        pinkie_sink_write(sink, buf, pos);
+    }
+}
+
+
+/*****************************************************************************/
+/** PINKIE Printf With Precompiled Format
+ *
+ * Buffered like pinkie_printf.
+ */
+void pinkie_printf_fmt(
+    const PINKIE_FMT_OP_T *op,                  /**< precompiled format */
+    ...                                         /**< variable arguments */
+)
+{
+    va_list ap;                                 /* variable argument list */
+#if PINKIE_CFG_PRINTF_BUF_LEN
+    char buf[PINKIE_CFG_PRINTF_BUF_LEN];        /* output buffer */
+    PINKIE_SINK_BUF_T sbuf;                     /* buffer sink */
+
+    pinkie_sink_buf_init(&sbuf, buf, sizeof(buf), &pinkie_sink_stdio);
+
+    va_start(ap, op);
+    pinkie_vprintf_fmt_sink(&sbuf.sink, op, ap);
+    va_end(ap);
+
+    pinkie_sink_buf_flush(&sbuf);
+#else
+    va_start(ap, op);
+    pinkie_vprintf_fmt_sink(&pinkie_sink_stdio, op, ap);
+    va_end(ap);
+#endif
+}
+
+
+/*****************************************************************************/
+/** PINKIE Just Enough Snprintf To Work
+ *
+ * The output is truncated to the buffer size and always terminated, unless
+ * the buffer size is zero.
+ *
+ * @returns length of the untruncated output
+ */
+int pinkie_snprintf(
+    char *buf,                                  /**< buffer */
+    unsigned int len,                           /**< buffer size */
+    const char *fmt,                            /**< format string */
+    ...                                         /**< variable arguments */
+)
+{
+    va_list ap;                                 /* variable argument list */
+    PINKIE_SINK_BUF_T sbuf;                     /* buffer sink */
+
+    pinkie_sink_buf_init(&sbuf, buf, len, NULL);
+
+    va_start(ap, fmt);
+    pinkie_vprintf_sink(&sbuf.sink, fmt, ap);
+    va_end(ap);
+
+    if (len) {
+        buf[sbuf.pos] = 0;
+    }
+
+    return (int) sbuf.cnt;
+}
+
+
 #ifndef pinkie_sscanf
 /*****************************************************************************/
 /** PINKIE Just Enough Sscanf To Work
  *
  * Supports the following formatters:
- *   - %u, with ll and hh modifiers
+ *   - %u and %i, with h, hh, l and ll modifiers, decimal or hex with 0x
  *   - %n
+ *
+ * Integers are read by pinkie_scan_int, values out of range stop the scan.
  */
 int pinkie_sscanf(
     const char *str,                            /**< input string */
@@ -222,10 +821,9 @@ int pinkie_sscanf(
     unsigned int int_width = 0;                 /* integer width */
     const char *str_beg = str;                  /* string begin */
     int args = 0;                               /* parsed arguments counter */
-    unsigned int flg_neg = 0;                   /* negative flag */
 
     va_start(ap, fmt);
-    for (; (*fmt) && (*str); fmt++) {
+    for (; (*fmt) && (str) && (*str); fmt++) {
 
         if (flg_format) {
 
@@ -244,45 +842,17 @@ int pinkie_sscanf(
             switch (*fmt) {
 
                 case 'i':
-
-                    /* detect negative sign */
-                    if ('-' == *str) {
-                        flg_neg = 1;
-                        continue;
-                    }
-
-                    /* fall through */
-
                 case 'u':
-                    /* unsigned integer */
-                    if (!int_width) {
-                        str = pinkie_s2i(str, sizeof(unsigned int), UINT_MAX, va_arg(ap, unsigned int *), flg_neg, 0);
-                    }
-                    else if (sizeof(uint8_t) == int_width) {
-                        str = pinkie_s2i(str, sizeof(uint8_t), UINT8_MAX, va_arg(ap, uint8_t *), flg_neg, 0);
-                    }
-#if (PINKIE_CFG_SSCANF_MAX_INT >= 2) && (UINT16_MAX != UINT_MAX)
-                    else if (sizeof(uint16_t) == int_width) {
-                        str = pinkie_s2i(str, sizeof(uint16_t), UINT16_MAX, va_arg(ap, uint16_t *), flg_neg, 0);
+                    str = pinkie_scan_int(str, NULL, (int_width) ? int_width : sizeof(int),
+                                          ('i' == *fmt) ? PINKIE_SCAN_SIGNED : PINKIE_SCAN_UNSIGNED,
+                                          va_arg(ap, void *));
+                    if (str) {
+                        args++;
                     }
-#endif
-#if (PINKIE_CFG_SSCANF_MAX_INT >= 4) && (UINT32_MAX != UINT_MAX)
-                    else if (sizeof(uint32_t) == int_width) {
-                        str = pinkie_s2i(str, sizeof(uint32_t), UINT32_MAX, va_arg(ap, uint32_t *), flg_neg, 0);
-                    }
-#endif
-#if (PINKIE_CFG_SSCANF_MAX_INT >= 8) && (UINT64_MAX != UINT_MAX)
-                    else if (sizeof(uint64_t) == int_width) {
-                        str = pinkie_s2i(str, sizeof(uint64_t), UINT64_MAX, va_arg(ap, uint64_t *), flg_neg, 0);
-                    }
-#endif
 
                     /* reset integer width */
                     int_width = 0;
 
-                    /* update args */
-                    args++;
-
                     break;
 
                 case '%':
@@ -297,7 +867,6 @@ int pinkie_sscanf(
             }
 
             flg_format = 0;
-            flg_neg = 0;
             continue;
         }
 
@@ -320,84 +889,174 @@ pinkie_sscanf_match:
 
 
 /*****************************************************************************/
-/** String To Integer
+/** Scan Integer
+ *
+ * Reads an optional minus sign and a decimal or, with 0x prefix, hexadecimal
+ * number in a single pass. Digits that can't overflow the scan integer are
+ * only multiplied and added, so on 32 and 64 bit hosts the loop divides at
+ * most for the last digit of the widest numbers. The value must fit width
+ * and range:
+ *   PINKIE_SCAN_UNSIGNED - 0 to unsigned max
+ *   PINKIE_SCAN_SIGNED - signed min to signed max
+ *   PINKIE_SCAN_ANY - signed min to unsigned max, e.g. -1 and 255 for a byte
+ *
+ * @returns position after the number or NULL if there is no number or it is
+ *          out of range, the value is only written on success
  */
-const char * pinkie_s2i(
+const char * pinkie_scan_int(
     const char *str,                            /**< string */
+    const char *end,                            /**< string end or NULL if zero terminated */
     unsigned int width,                         /**< width = sizeof(type) */
-    PINKIE_SSCANF_UINT_T num_max,               /**< max num value */
-    void *val,                                  /**< value */
-    unsigned int flg_neg,                       /**< negative flag */
-    unsigned int base                           /**< base */
+    unsigned int range,                         /**< value range */
+    void *val                                   /**< value */
 )
 {
     PINKIE_SSCANF_UINT_T num = 0;               /* number */
-    unsigned int mul = 1;                       /* multiplicator */
-    unsigned int cnt = 0;                       /* counter */
-    unsigned int cur;                           /* current number */
-    const char *str_end = NULL;                 /* number end */
-
-    /* detect number type */
-    if (0 == base) {
-        if (((str[0]) && ('0' == str[0])) && ((str[1]) && ('x' == str[1]))) {
-            base = 16;
-            str += 2;
-        } else {
-            base = 10;
+    PINKIE_SSCANF_UINT_T num_max;               /* max number of width */
+    unsigned int base = 10;                     /* number base */
+    unsigned int digit;                         /* current digit */
+    unsigned int cnt_safe;                      /* digits left without overflow check */
+    unsigned int flg_neg = 0;                   /* negative flag */
+    const char *str_num;                        /* first digit */
+
+    if ((!width) || (sizeof(PINKIE_SSCANF_UINT_T) < width)) {
+        return NULL;
+    }
+
+    if ((str != end) && ('-' == *str)) {
+        if (PINKIE_SCAN_UNSIGNED == range) {
+            return NULL;
         }
+        flg_neg = 1;
+        str++;
     }
 
-    /* count numbers */
-    for (; (*str) && (-1 != pinkie_c2i(*str, base)); str++) {
-        cnt++;
+    if ((str != end) && ('0' == str[0]) && ((str + 1) != end) && ('x' == (str[1] | 0x20))) {
+        base = 16;
+        str += 2;
     }
 
-    /* store number end */
-    str_end = str;
+    cnt_safe = (16 == base) ? (sizeof(PINKIE_SSCANF_UINT_T) * 2) : PINKIE_SCAN_DEC_SAFE;
 
-    /* check if anything was detected */
-    if (!cnt) {
-        goto bail;
-    }
+    for (str_num = str; str != end; str++) {
 
-    /* convert integers */
-    while (cnt--) {
-        str--;
+        digit = (unsigned int) (*str - '0');
+        if ((9 < digit) && (16 == base)) {
+            digit = (unsigned int) ((*str | 0x20) - 'a');
+            digit = (6 > digit) ? (digit + 10) : base;
+        }
 
-        /* apply multiplicator to conv result */
-        cur = pinkie_c2i(*str, base) * mul;
+        if (digit >= base) {
+            break;
+        }
 
-        if ((num_max - cur) <= num) {
-            str_end = 0;
-            goto bail;
+        if (cnt_safe) {
+            cnt_safe--;
+        }
+        else if (num > (((PINKIE_SSCANF_UINT_T) -1 - digit) / base)) {
+            return NULL;
         }
 
-        num += cur;
-        mul *= base;
+        num = (num * base) + digit;
+    }
+
+    if (str == str_num) {
+        return NULL;
     }
 
-bail:
-    /* convert result to given width */
+    /* check range of width */
+    num_max = ((PINKIE_SSCANF_UINT_T) -1) >> ((sizeof(PINKIE_SSCANF_UINT_T) - width) * 8);
+    if (flg_neg) {
+        if (num > ((num_max >> 1) + 1)) {
+            return NULL;
+        }
+        num = -num;
+    }
+    else if (num > ((PINKIE_SCAN_SIGNED == range) ? (num_max >> 1) : num_max)) {
+        return NULL;
+    }
+
+    /* store result in given width */
     if (sizeof(uint8_t) == width) {
-        *((uint8_t *) val) = (flg_neg) ? -num : num;
+        *((uint8_t *) val) = (uint8_t) num;
     }
 #if PINKIE_CFG_SSCANF_MAX_INT >= 2
     else if (sizeof(uint16_t) == width) {
-        *((uint16_t *) val) = (flg_neg) ? -num : num;
+        *((uint16_t *) val) = (uint16_t) num;
     }
 #endif
 #if PINKIE_CFG_SSCANF_MAX_INT >= 4
     else if (sizeof(uint32_t) == width) {
-        *((uint32_t *) val) = (flg_neg) ? -num : num;
+        *((uint32_t *) val) = (uint32_t) num;
     }
 #endif
 #if PINKIE_CFG_SSCANF_MAX_INT >= 8
     else if (sizeof(uint64_t) == width) {
-        *((uint64_t *) val) = (flg_neg) ? -num : num;
+        *((uint64_t *) val) = (uint64_t) num;
     }
 #endif
+    else {
+        return NULL;
+    }
+
+    return str;
+}
+
+
+/*****************************************************************************/
+/** Scan Byte List
+ *
+ * Reads a quoted string or a comma separated list of bytes in the range of
+ * PINKIE_SCAN_ANY, e.g. "1,0x02,-1". A string is copied up to the closing
+ * quote or the end, there are no escape sequences.
+ *
+ * @returns position after the list or NULL if a byte is invalid or the
+ *          buffer is too small
+ */
+const char * pinkie_scan_bytes(
+    const char *str,                            /**< string */
+    const char *end,                            /**< string end or NULL if zero terminated */
+    uint8_t *buf,                               /**< byte buffer */
+    unsigned int *len                           /**< buffer size, returns byte count */
+)
+{
+    unsigned int cnt = 0;                       /* byte count */
+
+    if ((str != end) && ('"' == *str)) {
+        for (str++; (str != end) && (*str) && ('"' != *str); str++) {
+            if (cnt == *len) {
+                return NULL;
+            }
+            buf[cnt++] = (uint8_t) *str;
+        }
+
+        if ((str != end) && ('"' == *str)) {
+            str++;
+        }
+
+        *len = cnt;
+        return str;
+    }
+
+    for (;;) {
+        if (cnt == *len) {
+            return NULL;
+        }
+
+        str = pinkie_scan_int(str, end, sizeof(uint8_t), PINKIE_SCAN_ANY, &buf[cnt]);
+        if (!str) {
+            return NULL;
+        }
+        cnt++;
+
+        if ((str == end) || (',' != *str)) {
+            break;
+        }
+        str++;
+    }
 
-    return str_end;
+    *len = cnt;
+    return str;
 }
 
 
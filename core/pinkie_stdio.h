@@ -3,10 +3,15 @@
  *
  * Provides functions:
  *   pinkie_i2s - integer to string
- *   pinkie_s2i - string to integer
  *   pinkie_c2i - character to integer
  *   pinkie_printf - printf
+ *   pinkie_printf_fmt - printf with precompiled format
+ *   pinkie_snprintf - snprintf
+ *   pinkie_vprintf_sink - vprintf to output sink
+ *   pinkie_vprintf_fmt_sink - vprintf with precompiled format to output sink
  *   pinkie_sscanf - sscanf
+ *   pinkie_scan_int - bounded string to integer with range check
+ *   pinkie_scan_bytes - bounded byte list or quoted string to buffer
  *
  * Most functions work from 8 to 64 bit.
  *
@@ -20,6 +25,14 @@
 #include <pinkie.h>
 
 
+/*****************************************************************************/
+/* Configuration */
+/*****************************************************************************/
+#ifndef PINKIE_CFG_PRINTF_BUF_LEN
+#  define PINKIE_CFG_PRINTF_BUF_LEN     0       /**< pinkie_printf stack buffer (0 = unbuffered) */
+#endif
+
+
 /*****************************************************************************/
 /* Defines */
 /*****************************************************************************/
@@ -43,6 +56,36 @@
 #  define PINKIE_PRINTF_UINT_T uint64_t
 #endif
 
+#define PINKIE_FMT_CONV_END             0       /**< format end */
+#define PINKIE_FMT_CONV_TEXT            1       /**< literal text */
+#define PINKIE_FMT_CONV_U               2       /**< unsigned decimal */
+#define PINKIE_FMT_CONV_X               3       /**< unsigned hexadecimal */
+#define PINKIE_FMT_CONV_I               4       /**< signed decimal */
+#define PINKIE_FMT_CONV_C               5       /**< character */
+#define PINKIE_FMT_CONV_S               6       /**< string */
+#define PINKIE_FMT_CONV_MASK            0x0f    /**< conversion mask */
+#define PINKIE_FMT_ZERO                 0x80    /**< pad with zeros */
+
+/**< precompiled format operations
+ *
+ * Integers take their argument type, e.g. PINKIE_FMT_U(REG_ADDR_T), so the
+ * width modifier can't mismatch. The pad count of PINKIE_FMT_INT works like
+ * the printf field width. Text is limited to 255 characters.
+ */
+#define PINKIE_FMT_END                  { NULL, PINKIE_FMT_CONV_END, 0, 0 }
+#define PINKIE_FMT_TEXT(str)            { str, PINKIE_FMT_CONV_TEXT, sizeof(str) - 1, 0 }
+#define PINKIE_FMT_INT(conv, type, pad) { NULL, conv, sizeof(type), pad }
+#define PINKIE_FMT_U(type)              PINKIE_FMT_INT(PINKIE_FMT_CONV_U, type, 1)
+#define PINKIE_FMT_I(type)              PINKIE_FMT_INT(PINKIE_FMT_CONV_I, type, 1)
+#define PINKIE_FMT_X(type)              PINKIE_FMT_INT(PINKIE_FMT_CONV_X, type, 1)
+#define PINKIE_FMT_X0(type, pad)        PINKIE_FMT_INT(PINKIE_FMT_CONV_X | PINKIE_FMT_ZERO, type, pad)
+#define PINKIE_FMT_C                    { NULL, PINKIE_FMT_CONV_C, 0, 0 }
+#define PINKIE_FMT_S                    { NULL, PINKIE_FMT_CONV_S, 0, 0 }
+
+#define PINKIE_SCAN_UNSIGNED            0       /**< scan range: unsigned */
+#define PINKIE_SCAN_SIGNED              1       /**< scan range: signed */
+#define PINKIE_SCAN_ANY                 2       /**< scan range: unsigned or negative signed */
+
 #if PINKIE_CFG_SSCANF_MAX_INT == 1
 #  define PINKIE_SSCANF_INT_T int8_t
 #  define PINKIE_SSCANF_UINT_T uint8_t
@@ -64,9 +107,92 @@
 #endif
 
 
+/*****************************************************************************/
+/* Data types */
+/*****************************************************************************/
+/**< output sink
+ *
+ * Sinks with own state embed this structure as their first member, so the
+ * callbacks get their state from the sink pointer.
+ */
+typedef struct PINKIE_SINK_T {
+    void (*put)(                                /**< put character */
+        struct PINKIE_SINK_T *sink,             /**< sink */
+        char chr                                /**< character */
+    );
+    void (*write)(                              /**< write block (NULL = put each character) */
+        struct PINKIE_SINK_T *sink,             /**< sink */
+        const char *data,                       /**< data */
+        unsigned int len                        /**< data length */
+    );
+} PINKIE_SINK_T;
+
+
+/**< memory buffer sink
+ *
+ * A full buffer is flushed to the next sink in one block. Without next sink
+ * the output is truncated, leaving room for the string termination.
+ */
+typedef struct {
+    PINKIE_SINK_T sink;                         /**< sink */
+    PINKIE_SINK_T *next;                        /**< flush target or NULL to truncate */
+    char *buf;                                  /**< buffer */
+    unsigned int len;                           /**< buffer size */
+    unsigned int pos;                           /**< buffer fill level */
+    unsigned int cnt;                           /**< total characters put */
+} PINKIE_SINK_BUF_T;
+
+
+/**< precompiled format operation
+ *
+ * A format is an array of operations built with the PINKIE_FMT_* macros and
+ * closed by PINKIE_FMT_END. The compiler does the parsing, so formatting
+ * only dispatches on the operations, e.g. "%u: 0x%02x\n" becomes:
+ *
+ *   static const PINKIE_FMT_OP_T fmt[] = {
+ *       PINKIE_FMT_U(REG_ADDR_T), PINKIE_FMT_TEXT(": 0x"),
+ *       PINKIE_FMT_X0(uint8_t, 2), PINKIE_FMT_TEXT("\n"), PINKIE_FMT_END
+ *   };
+ */
+typedef struct {
+    const char *text;                           /**< literal text */
+    uint8_t conv;                               /**< conversion and flags */
+    uint8_t len;                                /**< text length or integer width */
+    uint8_t pad;                                /**< pad count */
+} PINKIE_FMT_OP_T;
+
+
+/*****************************************************************************/
+/* External variables */
+/*****************************************************************************/
+extern PINKIE_SINK_T pinkie_sink_stdio;         /**< sink to pinkie_stdio_putc */
+
+
 /*****************************************************************************/
 /* Prototypes */
 /*****************************************************************************/
+void pinkie_sink_put(
+    PINKIE_SINK_T *sink,                        /**< sink */
+    char chr                                    /**< character */
+);
+
+void pinkie_sink_write(
+    PINKIE_SINK_T *sink,                        /**< sink */
+    const char *data,                           /**< data */
+    unsigned int len                            /**< data length */
+);
+
+void pinkie_sink_buf_init(
+    PINKIE_SINK_BUF_T *sbuf,                    /**< buffer sink */
+    char *buf,                                  /**< buffer */
+    unsigned int len,                           /**< buffer size */
+    PINKIE_SINK_T *next                         /**< flush target or NULL to truncate */
+);
+
+void pinkie_sink_buf_flush(
+    PINKIE_SINK_BUF_T *sbuf                     /**< buffer sink */
+);
+
 void pinkie_i2s(
     PINKIE_PRINTF_UINT_T num,                   /**< unsigned integer */
     unsigned int base,                          /**< base */
@@ -74,6 +200,38 @@ void pinkie_i2s(
     uint8_t cnt_pad                             /**< pad count */
 );
 
+void pinkie_i2s_sink(
+    PINKIE_SINK_T *sink,                        /**< sink */
+    PINKIE_PRINTF_UINT_T num,                   /**< unsigned integer */
+    unsigned int base,                          /**< base */
+    uint8_t flg_zero,                           /**< prefix with zero */
+    uint8_t cnt_pad                             /**< pad count */
+);
+
+void pinkie_vprintf_sink(
+    PINKIE_SINK_T *sink,                        /**< sink */
+    const char *fmt,                            /**< format string */
+    va_list ap                                  /**< variable argument list */
+) __attribute__((format(printf, 2, 0)));
+
+void pinkie_vprintf_fmt_sink(
+    PINKIE_SINK_T *sink,                        /**< sink */
+    const PINKIE_FMT_OP_T *op,                  /**< precompiled format */
+    va_list ap                                  /**< variable argument list */
+);
+
+void pinkie_printf_fmt(
+    const PINKIE_FMT_OP_T *op,                  /**< precompiled format */
+    ...                                         /**< variable arguments */
+);
+
+int pinkie_snprintf(
+    char *buf,                                  /**< buffer */
+    unsigned int len,                           /**< buffer size */
+    const char *fmt,                            /**< format string */
+    ...                                         /**< variable arguments */
+) __attribute__((format(printf, 3, 4)));
+
 #ifndef pinkie_printf
 void pinkie_printf(
     const char *fmt,                            /**< format string */
@@ -87,13 +245,19 @@ int pinkie_sscanf(
     ...                                         /**< variable arguments */
 ) __attribute__((format(scanf, 2, 3)));
 
-const char * pinkie_s2i(
+const char * pinkie_scan_int(
     const char *str,                            /**< string */
+    const char *end,                            /**< string end or NULL if zero terminated */
     unsigned int width,                         /**< width = sizeof(type) */
-    PINKIE_SSCANF_UINT_T num_max,               /**< max num value */
-    void *val,                                  /**< value */
-    unsigned int flg_neg,                       /**< negative flag */
-    unsigned int base                           /**< base */
+    unsigned int range,                         /**< value range */
+    void *val                                   /**< value */
+);
+
+const char * pinkie_scan_bytes(
+    const char *str,                            /**< string */
+    const char *end,                            /**< string end or NULL if zero terminated */
+    uint8_t *buf,                               /**< byte buffer */
+    unsigned int *len                           /**< buffer size, returns byte count */
 );
 
 int pinkie_c2i(
@@ -57,3 +57,25 @@ void pinkie_nvs_write(
     /* write EEPROM data */
     eeprom_write_block(data, 0, len);
 }
+
+
+/*****************************************************************************/
+/** PINKIE NVS Update
+ *
+ * Writes only the changed range and the CRC. Bytes that already match the
+ * EEPROM content are skipped to reduce wear and write time.
+ */
+void pinkie_nvs_update(
+    uint8_t *data,                              /**< NVS data ptr */
+    unsigned int len,                           /**< NVS data length */
+    unsigned int ofs,                           /**< changed data offset */
+    unsigned int cnt                            /**< changed data length */
+)
+{
+    /* skip CRC part and calculate CRC from read data */
+    *((uint16_t *) data) = pinkie_crc16(&data[2], len - 2, PINKIE_NVS_POLY);
+
+    /* update CRC and changed EEPROM data */
+    eeprom_update_block(data, 0, sizeof(uint16_t));
+    eeprom_update_block(&data[ofs], (void *) (uintptr_t) ofs, cnt);
+}
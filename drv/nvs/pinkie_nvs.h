@@ -24,5 +24,12 @@ void pinkie_nvs_write(
     unsigned int len                            /**< NVS data length */
 );
 
+void pinkie_nvs_update(
+    uint8_t *data,                              /**< NVS data ptr */
+    unsigned int len,                           /**< NVS data length */
+    unsigned int ofs,                           /**< changed data offset */
+    unsigned int cnt                            /**< changed data length */
+);
+
 
 #endif /* PINKIE_NVS_H */
@@ -22,6 +22,7 @@
 #include <drv/spi/pinkie_spi.h>
 #include <drv/timer/pinkie_timer.h>
 #include <drv/radio/rfm69/radio_rfm69.h>
+#include <pinkie_log.h>
 
 
 /*****************************************************************************/
@@ -212,7 +213,7 @@ void rfm69_opmode_set(
                            RFM69_SHF_IRQFLAGS1_MODEREADY)) {
 
         if (pinkie_timer_get() >= ts64) {
-            pinkie_printf("opmode: timeout\n");
+            PINKIE_LOG_WARN("opmode: timeout\n");
             break;
         }
     }
@@ -468,7 +469,7 @@ int rfm69_rssi_value(
                                                            RFM69_SHF_RSSICONFIG_RSSIDONE)) {
 
             if (pinkie_timer_get() >= ts64) {
-                pinkie_printf("rssi: timeout\n");
+                PINKIE_LOG_WARN("rssi: timeout\n");
                 return 0;
             }
         }
@@ -573,7 +574,7 @@ PINKIE_RES_T rfm69_send(
     ts64_tout = pinkie_timer_get() + RFM69_TIMEOUT_MS;
     while (1 != rfm69_flg_isr) {
         if (pinkie_timer_get() >= ts64_tout) {
-            pinkie_printf("send: timeout\n");
+            PINKIE_LOG_WARN("send: timeout\n");
             rfm69_fifo_clear();
             res = PINKIE_ERR_TIMEOUT;
             break;
@@ -762,7 +763,7 @@ uint8_t rfm69_temp(
                           RFM69_SHF_TEMP_MEAS_RUNNING)) {
 
         if (pinkie_timer_get() >= ts64) {
-            pinkie_printf("temp: timeout\n");
+            PINKIE_LOG_WARN("temp: timeout\n");
 
             /* previous opmode */
             rfm69_opmode_set(opmode);
@@ -809,7 +810,7 @@ void rfm69_rc_osc_cal(
                                                   RFM69_SHF_OSC1_RCCALDONE)) {
 
         if (pinkie_timer_get() >= ts64) {
-            pinkie_printf("rc_osc_cal: timeout\n");
+            PINKIE_LOG_WARN("rc_osc_cal: timeout\n");
             break;
         }
     }
@@ -0,0 +1,148 @@
+/**
+ * @brief PINKIE - Simulated Radio Channel
+ *
+ * Copyright (c) 2017, Sven Bachmann <dev@mcbachmann.de>
+ *
+ * Licensed under the MIT license, see LICENSE for details.
+ */
+#define _POSIX_C_SOURCE 200112L
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include "radio_sim.h"
+
+
+/*****************************************************************************/
+/* Local variables */
+/*****************************************************************************/
+static int sim_fd = -1;                         /**< channel socket */
+static uint8_t sim_node;                        /**< own node id */
+
+
+/*****************************************************************************/
+/* Local prototypes */
+/*****************************************************************************/
+static void radio_sim_addr(
+    struct sockaddr_in *addr,                   /**< socket address */
+    uint8_t node                                /**< node id */
+);
+
+
+/*****************************************************************************/
+/** Loopback address of node
+ */
+static void radio_sim_addr(
+    struct sockaddr_in *addr,                   /**< socket address */
+    uint8_t node                                /**< node id */
+)
+{
+    memset(addr, 0, sizeof(struct sockaddr_in));
+    addr->sin_family = AF_INET;
+    addr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr->sin_port = htons((uint16_t) (PINKIE_CFG_RADIO_SIM_PORT + node));
+}
+
+
+/*****************************************************************************/
+/** Join the channel
+ *
+ * @retval PINKIE_OK successful
+ * @retval other node id invalid or already in use
+ */
+PINKIE_RES_T radio_sim_init(
+    uint8_t node                                /**< own node id */
+)
+{
+    struct sockaddr_in addr;                    /* own address */
+
+    if (PINKIE_CFG_RADIO_SIM_NODES <= node) {
+        return 1;
+    }
+
+    sim_fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (0 > sim_fd) {
+        return 1;
+    }
+
+    radio_sim_addr(&addr, node);
+    if (bind(sim_fd, (struct sockaddr *) &addr, sizeof(addr))) {
+        close(sim_fd);
+        sim_fd = -1;
+        return 1;
+    }
+
+    sim_node = node;
+
+    return PINKIE_OK;
+}
+
+
+/*****************************************************************************/
+/** Send frame to all other nodes
+ *
+ * Nodes that aren't running simply miss the frame.
+ */
+PINKIE_RES_T radio_sim_send(
+    const uint8_t *data,                        /**< data */
+    uint8_t len                                 /**< data length */
+)
+{
+    struct sockaddr_in addr;                    /* node address */
+    uint8_t node;                               /* node id */
+
+    if ((0 > sim_fd) || (RADIO_SIM_FRAME_LEN < len)) {
+        return 1;
+    }
+
+    for (node = 0; node < PINKIE_CFG_RADIO_SIM_NODES; node++) {
+        if (node == sim_node) {
+            continue;
+        }
+
+        radio_sim_addr(&addr, node);
+        sendto(sim_fd, data, len, 0, (struct sockaddr *) &addr, sizeof(addr));
+    }
+
+    return PINKIE_OK;
+}
+
+
+/*****************************************************************************/
+/** Receive frame
+ *
+ * Doesn't block.
+ *
+ * @returns received frame length or 0 if no frame is available
+ */
+uint8_t radio_sim_recv(
+    uint8_t *data,                              /**< data buffer */
+    uint8_t len                                 /**< buffer length */
+)
+{
+    ssize_t res;                                /* result */
+
+    if (0 > sim_fd) {
+        return 0;
+    }
+
+    res = recv(sim_fd, data, len, MSG_DONTWAIT);
+    if (0 >= res) {
+        return 0;
+    }
+
+    return (uint8_t) res;
+}
+
+
+/*****************************************************************************/
+/** Channel file descriptor to wait for frames
+ */
+int radio_sim_fd(
+    void
+)
+{
+    return sim_fd;
+}
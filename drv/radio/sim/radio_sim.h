@@ -0,0 +1,58 @@
+/**
+ * @brief PINKIE - Simulated Radio Channel
+ *
+ * Emulates a shared radio channel between processes on one Linux host. Every
+ * node owns a UDP port on the loopback interface and a sent frame is
+ * delivered to all other nodes, like a broadcast on air.
+ *
+ * Copyright (c) 2017, Sven Bachmann <dev@mcbachmann.de>
+ *
+ * Licensed under the MIT license, see LICENSE for details.
+ */
+#ifndef RADIO_SIM_H
+#define RADIO_SIM_H
+
+#include <pinkie.h>
+
+
+/*****************************************************************************/
+/* Configuration */
+/*****************************************************************************/
+#ifndef PINKIE_CFG_RADIO_SIM_PORT
+#  define PINKIE_CFG_RADIO_SIM_PORT     47600   /**< UDP port of node 0 */
+#endif
+
+#ifndef PINKIE_CFG_RADIO_SIM_NODES
+#  define PINKIE_CFG_RADIO_SIM_NODES    4       /**< nodes on the channel */
+#endif
+
+
+/*****************************************************************************/
+/* Defines */
+/*****************************************************************************/
+#define RADIO_SIM_FRAME_LEN             66      /**< max frame length (RFM69 FIFO) */
+
+
+/*****************************************************************************/
+/* Prototypes */
+/*****************************************************************************/
+PINKIE_RES_T radio_sim_init(
+    uint8_t node                                /**< own node id */
+);
+
+PINKIE_RES_T radio_sim_send(
+    const uint8_t *data,                        /**< data */
+    uint8_t len                                 /**< data length */
+);
+
+uint8_t radio_sim_recv(
+    uint8_t *data,                              /**< data buffer */
+    uint8_t len                                 /**< buffer length */
+);
+
+int radio_sim_fd(
+    void
+);
+
+
+#endif /* RADIO_SIM_H */
@@ -62,7 +62,7 @@ ISR (TIMER0_COMPA_vect)
 
 
 /*****************************************************************************/
-/** Get current millisconds
+/** Get current milliseconds
  */
 uint64_t pinkie_timer_get(
     void
@@ -79,7 +79,7 @@ uint64_t pinkie_timer_get(
 
 
 /*****************************************************************************/
-/** Set current millisconds
+/** Set current milliseconds
  */
 void pinkie_timer_set(
     uint64_t ms_copy                            /* new ms */
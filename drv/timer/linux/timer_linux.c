@@ -0,0 +1,78 @@
+/**
+ * @brief PINKIE - Linux Timer Driver
+ *
+ * Derives the milliseconds from the monotonic clock, so the timer needs no
+ * interrupt or thread.
+ *
+ * Copyright (c) 2017, Sven Bachmann <dev@mcbachmann.de>
+ *
+ * Licensed under the MIT license, see LICENSE for details.
+ */
+#define _POSIX_C_SOURCE 199309L
+#include <stdint.h>
+#include <time.h>
+#include <drv/timer/pinkie_timer.h>
+
+
+/*****************************************************************************/
+/* Variables */
+/*****************************************************************************/
+static uint64_t ms_ofs = 0;                     /**< millisecond offset */
+
+
+/*****************************************************************************/
+/* Local prototypes */
+/*****************************************************************************/
+static uint64_t timer_linux_ms(
+    void
+);
+
+
+/*****************************************************************************/
+/** Monotonic clock in milliseconds
+ */
+static uint64_t timer_linux_ms(
+    void
+)
+{
+    struct timespec ts;                         /* timestamp */
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t) ts.tv_sec * 1000) + ((uint64_t) ts.tv_nsec / 1000000);
+}
+
+
+/*****************************************************************************/
+/** Timer Initialization
+ *
+ * Starts counting at zero.
+ */
+void pinkie_timer_init(
+    void
+)
+{
+    pinkie_timer_set(0);
+}
+
+
+/*****************************************************************************/
+/** Get current milliseconds
+ */
+uint64_t pinkie_timer_get(
+    void
+)
+{
+    return timer_linux_ms() - ms_ofs;
+}
+
+
+/*****************************************************************************/
+/** Set current milliseconds
+ */
+void pinkie_timer_set(
+    uint64_t ms_copy                            /* new ms */
+)
+{
+    ms_ofs = timer_linux_ms() - ms_copy;
+}
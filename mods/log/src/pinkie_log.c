@@ -0,0 +1,255 @@
+/**
+ * @brief PINKIE - Logging
+ *
+ * Messages are logged with a level. Levels above PINKIE_CFG_LOG_LVL are
+ * removed at compile time, the others are checked against pinkie_log_lvl. The
+ * application maps this variable as register to change the level remotely.
+ *
+ * Deferred logging sends a record instead of the formatted text:
+ *
+ *   MARK, format ID (16 bit), arguments, '\n'
+ *
+ * The format ID is the ROM offset of the format string to pinkie_log_base,
+ * sent in little endian. Integers are sent as variable length quantity with
+ * 7 bits per byte, least significant group first and bit 7 set on all but the
+ * last byte. Signed integers are zigzag encoded before, so small negative
+ * values stay short as well. Strings are sent zero terminated, characters as
+ * one byte and a '*' precision as unsigned integer. MARK, ESC, '\r' and '\n'
+ * inside a record are escaped by ESC and the byte XOR 0x20, so each record
+ * is a line of its own.
+ *
+ * Like pinkie_printf, a record is collected in PINKIE_CFG_PRINTF_BUF_LEN bytes
+ * on the stack if configured.
+ *
+ * The host tool mods/log/tools/pinkie_log_decode.py reads the format strings
+ * from the ELF file and expands the records. Other output is passed
+ * unchanged.
+ *
+ * Copyright (c) 2017, Sven Bachmann <dev@mcbachmann.de>
+ *
+ * Licensed under the MIT license, see LICENSE for details.
+ */
+#include <pinkie.h>
+#include "pinkie_log.h"
+
+
+/*****************************************************************************/
+/* Variables */
+/*****************************************************************************/
+uint8_t pinkie_log_lvl = PINKIE_CFG_LOG_LVL_INIT; /**< runtime level */
+
+
+#if PINKIE_CFG_LOG_DEFERRED == 1
+
+/*****************************************************************************/
+/* Local defines */
+/*****************************************************************************/
+#define PINKIE_LOG_LEN_NONE             0       /**< no length modifier */
+#define PINKIE_LOG_LEN_H                1       /**< length modifier h */
+#define PINKIE_LOG_LEN_HH               2       /**< length modifier hh */
+#define PINKIE_LOG_LEN_L                3       /**< length modifier l */
+#define PINKIE_LOG_LEN_LL               4       /**< length modifier ll */
+
+
+/*****************************************************************************/
+/* Local prototypes */
+/*****************************************************************************/
+static void pinkie_log_put(
+    PINKIE_SINK_T *sink,                        /**< sink */
+    uint8_t val                                 /**< byte */
+);
+
+static void pinkie_log_put_uint(
+    PINKIE_SINK_T *sink,                        /**< sink */
+    unsigned int val                            /**< value */
+);
+
+static void pinkie_log_put_ulong(
+    PINKIE_SINK_T *sink,                        /**< sink */
+    unsigned long long val                      /**< value */
+);
+
+
+/*****************************************************************************/
+/* Variables */
+/*****************************************************************************/
+const uint8_t pinkie_log_base PINKIE_ARCH_ROM = PINKIE_LOG_VERSION; /**< format ID base */
+
+
+/*****************************************************************************/
+/** Send escaped record byte
+ */
+static void pinkie_log_put(
+    PINKIE_SINK_T *sink,                        /**< sink */
+    uint8_t val                                 /**< byte */
+)
+{
+    if ((PINKIE_LOG_MARK == val) || (PINKIE_LOG_ESC == val) || ('\r' == val) || ('\n' == val)) {
+        sink->put(sink, PINKIE_LOG_ESC);
+        val ^= PINKIE_LOG_ESC_XOR;
+    }
+
+    sink->put(sink, (char) val);
+}
+
+
+/*****************************************************************************/
+/** Send int as variable length quantity
+ */
+static void pinkie_log_put_uint(
+    PINKIE_SINK_T *sink,                        /**< sink */
+    unsigned int val                            /**< value */
+)
+{
+    for (; val > 0x7f; val >>= 7) {
+        pinkie_log_put(sink, (uint8_t) (val | 0x80));
+    }
+
+    pinkie_log_put(sink, (uint8_t) val);
+}
+
+
+/*****************************************************************************/
+/** Send long long as variable length quantity
+ *
+ * Kept apart from pinkie_log_put_uint, so int values don't pay for wide
+ * shifts on 8-bit targets.
+ */
+static void pinkie_log_put_ulong(
+    PINKIE_SINK_T *sink,                        /**< sink */
+    unsigned long long val                      /**< value */
+)
+{
+    for (; val > 0x7f; val >>= 7) {
+        pinkie_log_put(sink, (uint8_t) (val | 0x80));
+    }
+
+    pinkie_log_put(sink, (uint8_t) val);
+}
+
+
+/*****************************************************************************/
+/** Emit deferred log record
+ *
+ * Only the conversions of pinkie_printf are supported.
+ */
+void pinkie_log_emit(
+    const char *fmt,                            /**< format string in ROM */
+    ...                                         /**< variable arguments */
+)
+{
+    va_list ap;                                 /* variable argument list */
+    char chr;                                   /* format character */
+    unsigned int flg_format = 0;                /* format flag */
+    unsigned int len_mod = PINKIE_LOG_LEN_NONE; /* length modifier */
+    int precision = INT_MAX;                    /* string precision */
+    uint16_t id;                                /* format ID */
+    int val_int;                                /* signed value */
+    unsigned int val;                           /* unsigned value */
+    const char *sub;                            /* sub string */
+#if PINKIE_CFG_PRINTF_BUF_LEN
+    char buf[PINKIE_CFG_PRINTF_BUF_LEN];        /* record buffer */
+    PINKIE_SINK_BUF_T sbuf;                     /* buffer sink */
+    PINKIE_SINK_T *sink = &sbuf.sink;           /* record sink */
+
+    pinkie_sink_buf_init(&sbuf, buf, sizeof(buf), &pinkie_sink_stdio);
+#else
+    PINKIE_SINK_T *sink = &pinkie_sink_stdio;   /* record sink */
+#endif
+
+    id = (uint16_t) ((uintptr_t) fmt - (uintptr_t) &pinkie_log_base);
+
+    sink->put(sink, PINKIE_LOG_MARK);
+    pinkie_log_put(sink, (uint8_t) id);
+    pinkie_log_put(sink, (uint8_t) (id >> 8));
+
+    va_start(ap, fmt);
+    for (;; fmt++) {
+
+        PINKIE_ARCH_ROM_READ(&chr, fmt, 1);
+        if (!chr) {
+            break;
+        }
+
+        if (!flg_format) {
+            flg_format = ('%' == chr);
+            continue;
+        }
+
+        switch (chr) {
+
+            case 'h':
+                len_mod = (PINKIE_LOG_LEN_H == len_mod) ? PINKIE_LOG_LEN_HH : PINKIE_LOG_LEN_H;
+                continue;
+
+            case 'l':
+                len_mod = (PINKIE_LOG_LEN_L == len_mod) ? PINKIE_LOG_LEN_LL : PINKIE_LOG_LEN_L;
+                continue;
+
+            case '*':
+                precision = va_arg(ap, int);
+                if (0 > precision) {
+                    precision = 0;
+                }
+                pinkie_log_put_uint(sink, (unsigned int) precision);
+                continue;
+
+            case 'i':
+                /* zigzag encoding, like pinkie_printf always an int */
+                val_int = va_arg(ap, int);
+                pinkie_log_put_uint(sink, ((unsigned int) val_int << 1) ^ (unsigned int) (val_int >> ((sizeof(int) * CHAR_BIT) - 1)));
+                break;
+
+            case 'u':
+            case 'x':
+                if (PINKIE_LOG_LEN_LL == len_mod) {
+                    pinkie_log_put_ulong(sink, va_arg(ap, unsigned long long));
+                }
+                else if (PINKIE_LOG_LEN_L == len_mod) {
+                    pinkie_log_put_ulong(sink, va_arg(ap, unsigned long));
+                }
+                else {
+                    val = va_arg(ap, unsigned int);
+                    if (PINKIE_LOG_LEN_HH == len_mod) {
+                        val &= 0xff;
+                    }
+                    else if (PINKIE_LOG_LEN_H == len_mod) {
+                        val &= 0xffff;
+                    }
+                    pinkie_log_put_uint(sink, val);
+                }
+                break;
+
+            case 'c':
+                pinkie_log_put(sink, (uint8_t) va_arg(ap, int));
+                break;
+
+            case 's':
+                for (sub = va_arg(ap, const char *); (precision--) && (*sub); sub++) {
+                    pinkie_log_put(sink, (uint8_t) *sub);
+                }
+                pinkie_log_put(sink, 0);
+                break;
+
+            case '%':
+                break;
+
+            default:
+                /* flags, pad count and precision dot */
+                continue;
+        }
+
+        flg_format = 0;
+        len_mod = PINKIE_LOG_LEN_NONE;
+        precision = INT_MAX;
+    }
+    va_end(ap);
+
+    sink->put(sink, '\n');
+
+#if PINKIE_CFG_PRINTF_BUF_LEN
+    pinkie_sink_buf_flush(&sbuf);
+#endif
+}
+
+#endif /* PINKIE_CFG_LOG_DEFERRED */
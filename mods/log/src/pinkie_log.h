@@ -0,0 +1,121 @@
+/**
+ * @brief PINKIE - Logging
+ *
+ * Copyright (c) 2017, Sven Bachmann <dev@mcbachmann.de>
+ *
+ * Licensed under the MIT license, see LICENSE for details.
+ */
+#ifndef PINKIE_LOG_H
+#define PINKIE_LOG_H
+
+#include <pinkie.h>
+
+
+/*****************************************************************************/
+/* Configuration */
+/*****************************************************************************/
+#ifndef PINKIE_CFG_LOG_DEFERRED
+#  define PINKIE_CFG_LOG_DEFERRED       0       /**< emit format IDs instead of text */
+#endif
+
+#ifndef PINKIE_CFG_LOG_LVL
+#  define PINKIE_CFG_LOG_LVL            PINKIE_LOG_LVL_DBG  /**< highest compiled level */
+#endif
+
+#ifndef PINKIE_CFG_LOG_LVL_INIT
+#  define PINKIE_CFG_LOG_LVL_INIT       PINKIE_LOG_LVL_INFO /**< runtime level after start */
+#endif
+
+
+/*****************************************************************************/
+/* Defines */
+/*****************************************************************************/
+#define PINKIE_LOG_VERSION              1       /**< deferred record version */
+#define PINKIE_LOG_MARK                 0x1f    /**< deferred record start */
+#define PINKIE_LOG_ESC                  0x1e    /**< deferred record escape */
+#define PINKIE_LOG_ESC_XOR              0x20    /**< escaped byte modifier */
+
+#define PINKIE_LOG_LVL_NONE             0       /**< level: nothing */
+#define PINKIE_LOG_LVL_ERR              1       /**< level: errors */
+#define PINKIE_LOG_LVL_WARN             2       /**< level: warnings */
+#define PINKIE_LOG_LVL_INFO             3       /**< level: information */
+#define PINKIE_LOG_LVL_DBG              4       /**< level: debug output */
+
+
+/**< log a printf formatted message
+ *
+ * In deferred mode the format string is placed in ROM and only its ID and the
+ * raw arguments are sent. The trailing zero only keeps the argument list
+ * non-empty for messages without arguments.
+ */
+#if PINKIE_CFG_LOG_DEFERRED == 1
+#  define PINKIE_LOG(...)               PINKIE_LOG_DEFERRED(__VA_ARGS__, 0)
+#  define PINKIE_LOG_DEFERRED(fmt, ...) \
+    do { \
+        static const char pinkie_log_fmt[] PINKIE_ARCH_ROM = fmt; \
+        pinkie_log_emit(pinkie_log_fmt, __VA_ARGS__); \
+    } while (0)
+#else
+#  define PINKIE_LOG(...)               pinkie_printf(__VA_ARGS__)
+#endif
+
+
+/**< check if a level is compiled in and enabled at runtime */
+#define PINKIE_LOG_ENABLED(lvl)         (((lvl) <= PINKIE_CFG_LOG_LVL) && ((lvl) <= pinkie_log_lvl))
+
+
+/**< log a message if its level is enabled at runtime
+ *
+ * Levels above PINKIE_CFG_LOG_LVL compile to nothing, their arguments aren't
+ * evaluated.
+ */
+#define PINKIE_LOG_AT(lvl, ...) \
+    do { \
+        if ((lvl) <= pinkie_log_lvl) { \
+            PINKIE_LOG(__VA_ARGS__); \
+        } \
+    } while (0)
+
+#if PINKIE_CFG_LOG_LVL >= PINKIE_LOG_LVL_ERR
+#  define PINKIE_LOG_ERR(...)           PINKIE_LOG_AT(PINKIE_LOG_LVL_ERR, __VA_ARGS__)
+#else
+#  define PINKIE_LOG_ERR(...)           do { } while (0)
+#endif
+
+#if PINKIE_CFG_LOG_LVL >= PINKIE_LOG_LVL_WARN
+#  define PINKIE_LOG_WARN(...)          PINKIE_LOG_AT(PINKIE_LOG_LVL_WARN, __VA_ARGS__)
+#else
+#  define PINKIE_LOG_WARN(...)          do { } while (0)
+#endif
+
+#if PINKIE_CFG_LOG_LVL >= PINKIE_LOG_LVL_INFO
+#  define PINKIE_LOG_INFO(...)          PINKIE_LOG_AT(PINKIE_LOG_LVL_INFO, __VA_ARGS__)
+#else
+#  define PINKIE_LOG_INFO(...)          do { } while (0)
+#endif
+
+#if PINKIE_CFG_LOG_LVL >= PINKIE_LOG_LVL_DBG
+#  define PINKIE_LOG_DBG(...)           PINKIE_LOG_AT(PINKIE_LOG_LVL_DBG, __VA_ARGS__)
+#else
+#  define PINKIE_LOG_DBG(...)           do { } while (0)
+#endif
+
+
+/*****************************************************************************/
+/* External variables */
+/*****************************************************************************/
+extern uint8_t pinkie_log_lvl;                  /**< runtime level, map it as register */
+
+
+/*****************************************************************************/
+/* Prototypes */
+/*****************************************************************************/
+#if PINKIE_CFG_LOG_DEFERRED == 1
+void pinkie_log_emit(
+    const char *fmt,                            /**< format string in ROM */
+    ...                                         /**< variable arguments */
+);
+#endif
+
+
+#endif /* PINKIE_LOG_H */
@@ -0,0 +1,226 @@
+#!/usr/bin/env python3
+#
+# PINKIE - Deferred Log Decoder
+#
+# Expands deferred log records of a PINKIE application. The format strings
+# are read from the ELF file of the application, other output is passed
+# unchanged.
+#
+# Usage: pinkie_log_decode.py ELF [INPUT]
+#
+# INPUT defaults to standard input and can also be a configured serial port,
+# e.g. after "stty -F /dev/ttyUSB0 57600 raw".
+#
+# Copyright (c) 2017, Sven Bachmann <dev@mcbachmann.de>
+#
+# Licensed under the MIT license, see LICENSE for details.
+#
+import re
+import struct
+import sys
+
+
+LOG_MARK = 0x1f                                 # deferred record start
+LOG_ESC = 0x1e                                  # deferred record escape
+LOG_ESC_XOR = 0x20                              # escaped byte modifier
+
+LOG_VERSION = 1                                 # deferred record version
+LOG_BASE = "pinkie_log_base"                    # ID base symbol
+LOG_FMT = re.compile(r"^pinkie_log_fmt\.\d+$")  # format string symbols
+LOG_SPEC = re.compile(r"%([0-9]*)(\.\*)?(?:h{1,2}|l{1,2})?([iuxcs%])")
+
+SHT_SYMTAB = 2                                  # ELF symbol table section
+
+
+class Elf:
+    """Minimal little endian ELF reader for symbols and section data"""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = f.read()
+
+        if self.data[:4] != b"\x7fELF":
+            raise ValueError("%s: not an ELF file" % path)
+
+        if self.data[5] != 1:
+            raise ValueError("%s: only little endian ELF files are supported" % path)
+
+        self.is64 = (self.data[4] == 2)
+        if self.is64:
+            shoff, = struct.unpack_from("<Q", self.data, 0x28)
+            shentsize, shnum = struct.unpack_from("<HH", self.data, 0x3a)
+        else:
+            shoff, = struct.unpack_from("<I", self.data, 0x20)
+            shentsize, shnum = struct.unpack_from("<HH", self.data, 0x2e)
+
+        self.sections = []
+        for idx in range(shnum):
+            ofs = shoff + idx * shentsize
+            if self.is64:
+                _, sh_type, _, sh_addr, sh_offset, sh_size, sh_link, _, _, sh_entsize = \
+                    struct.unpack_from("<IIQQQQIIQQ", self.data, ofs)
+            else:
+                _, sh_type, _, sh_addr, sh_offset, sh_size, sh_link, _, _, sh_entsize = \
+                    struct.unpack_from("<IIIIIIIIII", self.data, ofs)
+            self.sections.append((sh_type, sh_addr, sh_offset, sh_size, sh_link, sh_entsize))
+
+    def symbols(self):
+        """Yield name, value and section index of all symbols"""
+        for sh_type, _, sh_offset, sh_size, sh_link, sh_entsize in self.sections:
+            if sh_type != SHT_SYMTAB:
+                continue
+
+            str_offset = self.sections[sh_link][2]
+            for ofs in range(sh_offset, sh_offset + sh_size, sh_entsize):
+                if self.is64:
+                    st_name, _, _, st_shndx, st_value, _ = struct.unpack_from("<IBBHQQ", self.data, ofs)
+                else:
+                    st_name, st_value, _, _, _, st_shndx = struct.unpack_from("<IIIBBH", self.data, ofs)
+
+                end = self.data.index(b"\0", str_offset + st_name)
+                yield self.data[str_offset + st_name:end].decode(), st_value, st_shndx
+
+    def read(self, shndx, addr, length=None):
+        """Read data at address, zero terminated if no length is given"""
+        _, sh_addr, sh_offset, sh_size, _, _ = self.sections[shndx]
+        ofs = sh_offset + addr - sh_addr
+
+        if length is None:
+            length = self.data.index(b"\0", ofs) - ofs
+
+        return self.data[ofs:ofs + length]
+
+
+class Decoder:
+    """Deferred log record decoder"""
+
+    def __init__(self, path):
+        elf = Elf(path)
+        syms = list(elf.symbols())
+
+        base = [sym for sym in syms if sym[0] == LOG_BASE]
+        if not base:
+            raise ValueError("%s: no deferred logging (missing %s)" % (path, LOG_BASE))
+
+        _, base_addr, base_shndx = base[0]
+        version = elf.read(base_shndx, base_addr, 1)[0]
+        if version != LOG_VERSION:
+            raise ValueError("%s: unsupported record version %u" % (path, version))
+
+        self.fmts = {}
+        for name, addr, shndx in syms:
+            if not LOG_FMT.match(name):
+                continue
+
+            fmt_id = (addr - base_addr) & 0xffff
+            if fmt_id in self.fmts:
+                sys.stderr.write("format ID 0x%04x isn't unique\n" % fmt_id)
+            self.fmts[fmt_id] = elf.read(shndx, addr).decode(errors="replace")
+
+    def record(self, data):
+        """Expand unescaped record"""
+        if len(data) < 2:
+            return "<truncated log record>\n"
+
+        fmt_id, = struct.unpack_from("<H", data)
+        fmt = self.fmts.get(fmt_id)
+        if fmt is None:
+            return "<unknown log format 0x%04x>\n" % fmt_id
+
+        ofs = [2]
+
+        def take():
+            val = 0
+            shift = 0
+            while True:
+                byte = data[ofs[0]]
+                ofs[0] += 1
+                val |= (byte & 0x7f) << shift
+                shift += 7
+                if not byte & 0x80:
+                    return val
+
+        def conv(match):
+            pad, prec, spec = match.groups()
+            if spec == "%":
+                return "%"
+
+            args = []
+            if prec:
+                args.append(take())
+
+            if spec == "c":
+                args.append(chr(data[ofs[0]]))
+                ofs[0] += 1
+            elif spec == "s":
+                end = data.index(0, ofs[0])
+                args.append(data[ofs[0]:end].decode(errors="replace"))
+                ofs[0] = end + 1
+            elif spec == "i":
+                val = take()
+                args.append((val >> 1) ^ -(val & 1))
+                spec = "d"
+            else:
+                args.append(take())
+                spec = "d" if spec == "u" else spec
+
+            return ("%" + pad + (prec or "") + spec) % tuple(args)
+
+        try:
+            return LOG_SPEC.sub(conv, fmt)
+        except (IndexError, ValueError):
+            return "<malformed log record 0x%04x>\n" % fmt_id
+
+    def run(self, inp, out):
+        """Pass output and expand records until end of input"""
+        rec = None
+        esc = False
+
+        while True:
+            chunk = inp.read1(256) if hasattr(inp, "read1") else inp.read(256)
+            if not chunk:
+                break
+
+            for val in chunk:
+                if rec is None:
+                    if val == LOG_MARK:
+                        rec = bytearray()
+                        esc = False
+                    else:
+                        out.write(bytes((val,)))
+                    continue
+
+                if val == ord("\n"):
+                    out.write(self.record(bytes(rec)).encode())
+                    rec = None
+                elif val == ord("\r"):
+                    pass
+                elif esc:
+                    rec.append(val ^ LOG_ESC_XOR)
+                    esc = False
+                elif val == LOG_ESC:
+                    esc = True
+                else:
+                    rec.append(val)
+
+            out.flush()
+
+
+def main():
+    if len(sys.argv) not in (2, 3):
+        sys.stderr.write("Usage: %s ELF [INPUT]\n" % sys.argv[0])
+        return 1
+
+    dec = Decoder(sys.argv[1])
+
+    if len(sys.argv) == 3:
+        with open(sys.argv[2], "rb", buffering=0) as inp:
+            dec.run(inp, sys.stdout.buffer)
+    else:
+        dec.run(sys.stdin.buffer, sys.stdout.buffer)
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,25 @@
+/**
+ * @brief RegReg - Static register table placement for AVR
+ *
+ * Extends the default AVR linker script. The static register entries are
+ * placed in flash right behind .text, so they stay in the lower 64k that
+ * memcpy_P() can read. KEEP protects them from --gc-sections, the start and
+ * stop symbols replace the ones ld only creates for orphan sections. The
+ * initialized data is loaded from flash behind the table.
+ *
+ * The entries are sorted by regreg_tbl.py after linking.
+ *
+ * Copyright (c) 2017, Sven Bachmann <dev@mcbachmann.de>
+ *
+ * Licensed under the MIT license, see LICENSE for details.
+ */
+SECTIONS
+{
+    regreg_tbl :
+    {
+        __start_regreg_tbl = .;
+        KEEP(*(regreg_tbl))
+        __stop_regreg_tbl = .;
+    }
+}
+INSERT AFTER .text;
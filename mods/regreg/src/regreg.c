@@ -1,6 +1,53 @@
 /**
  * @brief RegReg - Everything is a register
  *
+ * Registers are either defined statically by REGREG_ENTRY or added at runtime
+ * by reg_add().
+ *
+ * Static registers are collected by the linker in a table that is checked by
+ * reg_init(). If the table is sorted by address a binary search is used,
+ * otherwise it is scanned linearly.
+ *
+ * Dynamic registers are kept in an index that is sorted by start address.
+ * This allows a binary search on every access and detects overlapping ranges
+ * when a register is added.
+ *
+ * With PINKIE_CFG_REGREG_ADDR32 addresses are 32 bit wide. Each context then
+ * keeps a two-level page table that maps every 64k address window to its
+ * slice of the index, so sparse maps don't slow down the lookup. The table is
+ * rebuilt when a register is added.
+ *
+ * Every register space is a context. The global API uses a default context
+ * that also contains the static table. Further contexts bring their own index
+ * storage, so many independent register spaces can exist in one process.
+ *
+ * In concurrent mode (Linux) the index is published as a read-only snapshot.
+ * Lookups don't take locks, they only mark their thread as active in the
+ * current epoch. Writers replace the snapshot and free the old one once all
+ * readers left the previous epoch. Reader slots are returned when their
+ * thread exits. Accesses to entries with a callback, cache or NVS write-back
+ * are serialized per entry by striped locks, so callbacks never run in
+ * parallel for the same entry and must not access other registers. Plain data
+ * entries are copied without a lock.
+ *
+ * With PINKIE_CFG_REGREG_TYPES each entry describes its values by width,
+ * signedness and byte order. reg_ctx_type() tells if a complete value starts
+ * at an address, so it can be read and announced as a whole instead of byte
+ * by byte.
+ *
+ * Registers with expensive callbacks can use a value cache. Reads are served
+ * from the cache until its TTL expires, writes invalidate it.
+ *
+ * If a callback rejects a write with REGREG_RES_BUSY, the write can be put in
+ * a bounded pending queue. reg_pend_process() replays it from the main loop
+ * and announces the completion on the pending status registers.
+ *
+ * Writes can be grouped by a transaction (see regreg_txn.c). They are staged
+ * by reg_txn_stage() and written on commit.
+ *
+ * Data of persistent entries is marked dirty on write and written back to NVS
+ * later (see regreg_nvs.c).
+ *
  * Copyright (c) 2017, Sven Bachmann <dev@mcbachmann.de>
  *
  * Licensed under the MIT license, see LICENSE for details.
@@ -8,97 +55,1876 @@
 #include <string.h>
 #include "regreg.h"
 
+#if (PINKIE_CFG_REGREG_CACHE == 1) || (PINKIE_CFG_REGREG_STATS == 1)
+#  include <drv/timer/pinkie_timer.h>
+#endif
+
+#if PINKIE_CFG_REGREG_CONCURRENT == 1
+#  include <pthread.h>
+#  include <sched.h>
+#  include <stdlib.h>
+#endif
+
+
+/*****************************************************************************/
+/* Local defines */
+/*****************************************************************************/
+#if PINKIE_CFG_REGREG_CONCURRENT == 1
+#  if PINKIE_CFG_REGREG_CACHE == 1
+#    define REG_LOCK_CACHE(reg)         ((reg)->cache)
+#  else
+#    define REG_LOCK_CACHE(reg)         0
+#  endif
+#  if PINKIE_CFG_REGREG_NVS == 1
+#    define REG_LOCK_FLG(reg)           ((reg)->flg)
+#  else
+#    define REG_LOCK_FLG(reg)           0
+#  endif
+
+/**< entries with callback, cache or NVS write-back need the entry lock */
+#  define REG_LOCK_NEEDED(reg)          ((reg)->cb || REG_LOCK_CACHE(reg) || REG_LOCK_FLG(reg))
+
+#  define REG_STAT_INC(x)               __atomic_fetch_add(&(x), 1, __ATOMIC_RELAXED)
+#  define REG_STAT_ADD(x, v)            __atomic_fetch_add(&(x), v, __ATOMIC_RELAXED)
+#else
+#  define REG_STAT_INC(x)               (x)++
+#  define REG_STAT_ADD(x, v)            (x) += (v)
+#endif
+
+#define REG_VEC_OPEN                    0       /**< vectored access: not handled yet */
+#define REG_VEC_GRP                     1       /**< vectored access: member of current group */
+#define REG_VEC_DONE                    2       /**< vectored access: handled */
+
+#if PINKIE_CFG_REGREG_ADDR32 == 1
+#  define REG_TBL_ADDR_LEN              "4"     /**< register address width */
+#else
+#  define REG_TBL_ADDR_LEN              "2"     /**< register address width */
+#endif
+
+
+/*****************************************************************************/
+/* Linker symbols */
+/*****************************************************************************/
+extern const REG_ENTRY_T __start_regreg_tbl[] __attribute__((weak)); /**< static table start */
+extern const REG_ENTRY_T __stop_regreg_tbl[] __attribute__((weak)); /**< static table end */
+
+/* absolute symbol, tells regreg_tbl.py the address width of the entries */
+__asm__(".globl regreg_tbl_addr_len\n\t.set regreg_tbl_addr_len, " REG_TBL_ADDR_LEN);
+
+
+/*****************************************************************************/
+/* Local datatypes */
+/*****************************************************************************/
+#if PINKIE_CFG_REGREG_CONCURRENT == 1
+/**< published register index snapshot */
+typedef struct REGREG_SNAP_T {
+    unsigned int cnt;                           /**< register count */
+#if PINKIE_CFG_REGREG_ADDR32 == 1
+    REGREG_PT_T pt;                             /**< page table */
+#endif
+    REG_ENTRY_T *regs[];                        /**< sorted register index */
+} REGREG_SNAP_T;
+
+
+/**< reader epoch slot, aligned to a cache line to avoid false sharing */
+typedef struct {
+    uint64_t epoch;                             /**< active epoch (0 = idle) */
+    uint8_t flg_used;                           /**< slot assigned to a thread */
+} __attribute__((aligned(64))) REG_READER_T;
+
+
+/**< striped entry lock, aligned to a cache line to avoid false sharing */
+typedef struct {
+    pthread_mutex_t lock;                       /**< entry lock */
+} __attribute__((aligned(64))) REG_LOCK_T;
+#endif
+
+
+#if PINKIE_CFG_REGREG_PEND_CNT > 0
+/**< pending write */
+typedef struct {
+    REGREG_CTX_T *ctx;                          /**< register context */
+    REG_ADDR_T addr;                            /**< start address */
+    uint8_t len;                                /**< data length */
+    uint8_t ofs;                                /**< already written data */
+    uint8_t data[PINKIE_CFG_REGREG_PEND_LEN];   /**< data */
+} REG_PEND_T;
+#endif
+
 
 /*****************************************************************************/
 /* Local variables */
 /*****************************************************************************/
-static REG_ENTRY_T *regs = NULL;                /* register list */
+static REG_ENTRY_T *regs_dfl[PINKIE_CFG_REGREG_ENTRIES]; /**< default register index */
+static uint8_t flg_tbl_sorted = 0;              /**< static table sorted flag */
+
+static REGREG_CTX_T reg_ctx_dfl = {             /**< default register context */
+    regs_dfl,
+    PINKIE_CFG_REGREG_ENTRIES,
+    0,
+    1,
+    NULL,
+    NULL,
+#if PINKIE_CFG_REGREG_ADDR32 == 1
+    { { 0 }, 0, { { { 0, 0 } } } },
+#endif
+#if PINKIE_CFG_REGREG_CONCURRENT == 1
+    NULL,
+#endif
+};
+
+#if PINKIE_CFG_REGREG_CONCURRENT == 1
+static pthread_mutex_t reg_wr_lock = PTHREAD_MUTEX_INITIALIZER; /**< writer lock */
+static REG_LOCK_T reg_locks[PINKIE_CFG_REGREG_LOCKS]; /**< striped entry locks */
+static pthread_once_t reg_locks_once = PTHREAD_ONCE_INIT; /**< entry lock and reader key init */
+static pthread_key_t reg_reader_key;            /**< reader slot release at thread exit */
+static REG_READER_T reg_readers[PINKIE_CFG_REGREG_READERS]; /**< reader epoch slots */
+static uint64_t reg_epoch = 1;                  /**< current epoch */
+static __thread int reg_reader_slot = -1;       /**< thread reader slot */
+#endif
+
+#if PINKIE_CFG_REGREG_CACHE == 1
+static REGREG_CACHE_STAT_T cache_stat;          /**< cache statistics */
+
+static REG_ENTRY_T cache_regreg_info =          /**< cache statistics register */
+    REGREG_ENTRY_INIT_TYPED(0, sizeof(REGREG_CACHE_STAT_T) - 1, NULL, &cache_stat, NULL, REGREG_TYPE_U16);
+#endif
+
+#if PINKIE_CFG_REGREG_PEND_CNT > 0
+static REG_PEND_T pends[PINKIE_CFG_REGREG_PEND_CNT]; /**< pending write queue */
+static uint8_t pends_rd = 0;                    /**< first pending write */
+static uint8_t pends_cnt = 0;                   /**< pending write count */
+static REGREG_PEND_STAT_T pend_stat;            /**< pending write status */
+
+static REG_ENTRY_T pend_regreg_info =           /**< pending write status register */
+    REGREG_ENTRY_INIT(0, sizeof(REGREG_PEND_STAT_T) - 1, NULL, &pend_stat, NULL);
+#endif
+
+#if PINKIE_CFG_REGREG_STATS == 1
+static REGREG_STAT_REG_T stat_reg;              /**< statistics register block */
+static REGREG_STAT_T stat_regreg_stat;          /**< statistics of statistics register */
+
+static unsigned int reg_stat_cb(
+    REG_ENTRY_T *reg,                           /**< register */
+    REG_ACC_T *reg_acc                          /**< register access info */
+);
+
+static REG_ENTRY_T stat_regreg_info =           /**< statistics register */
+    REGREG_ENTRY_INIT_STAT(0, sizeof(REGREG_STAT_REG_T) - 1, reg_stat_cb, &stat_reg, NULL, REGREG_TYPE_NONE, &stat_regreg_stat);
+#endif
 
 
 /*****************************************************************************/
-/** Add a register handler
- */
-void reg_add(
+/* Local prototypes */
+/*****************************************************************************/
+static unsigned int reg_idx_find(
+    REG_ENTRY_T * const *regs,                  /**< register index */
+    unsigned int cnt,                           /**< register count */
+    REG_ADDR_T addr                             /**< register address */
+);
+
+#if PINKIE_CFG_REGREG_ADDR32 == 1
+static unsigned int reg_pt_build(
+    REGREG_PT_T *pt,                            /**< page table */
+    REG_ENTRY_T * const *regs,                  /**< register index */
+    unsigned int cnt                            /**< register count */
+);
+
+static REG_ENTRY_T * reg_pt_find(
+    const REGREG_PT_T *pt,                      /**< page table */
+    REG_ENTRY_T * const *regs,                  /**< register index */
+    REG_ADDR_T addr                             /**< register address */
+);
+#endif
+
+#if PINKIE_CFG_REGREG_CONCURRENT == 1
+static void reg_locks_init(
+    void
+);
+
+static pthread_mutex_t * reg_lock_get(
+    REGREG_CTX_T *ctx,                          /**< register context */
+    REG_ENTRY_T *reg                            /**< register */
+);
+
+static void reg_reader_release(
+    void *arg                                   /**< reader slot + 1 */
+);
+
+static int reg_reader_acquire(
+    void
+);
+
+static REGREG_SNAP_T * reg_read_enter(
+    REGREG_CTX_T *ctx                           /**< register context */
+);
+
+static void reg_read_leave(
+    void
+);
+
+static void reg_snap_publish(
+    REGREG_CTX_T *ctx,                          /**< register context */
+    REGREG_SNAP_T *snap                         /**< new snapshot */
+);
+#endif
+
+static unsigned int reg_idx_add(
+    REGREG_CTX_T *ctx,                          /**< register context */
     REG_ENTRY_T *reg                            /**< register entry pointer */
+);
+
+static unsigned int reg_tbl_cnt(
+    void
+);
+
+static const REG_ENTRY_T * reg_tbl_get(
+    unsigned int pos,                           /**< table position */
+    REG_ENTRY_T *buf                            /**< entry buffer */
+);
+
+static REG_ENTRY_T * reg_tbl_find(
+    REG_ADDR_T addr_beg,                        /**< start address */
+    REG_ADDR_T addr_end,                        /**< end address */
+    REG_ENTRY_T *buf                            /**< entry buffer */
+);
+
+#if PINKIE_CFG_REGREG_STATS == 1
+static void reg_stat_time(
+    REGREG_STAT_T *stat,                        /**< register statistics */
+    uint32_t time,                              /**< callback time */
+    unsigned int res                            /**< callback result */
+);
+#endif
+
+static unsigned int reg_rw_cb(
+    REG_ENTRY_T *reg,                           /**< register */
+    REG_ACC_T *reg_acc                          /**< register access info */
+);
+
+#if PINKIE_CFG_REGREG_CACHE == 1
+static unsigned int reg_cache_fill(
+    REG_ENTRY_T *reg,                           /**< register */
+    REG_ACC_T *reg_acc                          /**< register access info */
+);
+
+static unsigned int reg_cache_read(
+    REG_ENTRY_T *reg,                           /**< register */
+    REG_ACC_T *reg_acc                          /**< register access info */
+);
+#endif
+
+#if PINKIE_CFG_REGREG_PEND_CNT > 0
+static unsigned int reg_pend_find(
+    REGREG_CTX_T *ctx,                          /**< register context */
+    REG_ENTRY_T *reg                            /**< register */
+);
+
+static unsigned int reg_pend_add(
+    REGREG_CTX_T *ctx,                          /**< register context */
+    REG_ACC_T *reg_acc                          /**< register access info */
+);
+#endif
+
+static unsigned int reg_rw_entry(
+    REGREG_CTX_T *ctx,                          /**< register context */
+    REG_ENTRY_T *reg,                           /**< register */
+    REG_ACC_T *reg_acc                          /**< register access info */
+);
+
+static unsigned int reg_rw_range(
+    REGREG_CTX_T *ctx,                          /**< register context */
+    REG_ENTRY_T *reg,                           /**< register */
+    REG_ACC_T *reg_acc                          /**< register access info */
+);
+
+static unsigned int reg_vec_res(
+    uint8_t *res_list,                          /**< result list (optional) */
+    unsigned int pos,                           /**< list position */
+    unsigned int res                            /**< access result */
+);
+
+
+/*****************************************************************************/
+/** Find index position
+ *
+ * Returns the position of the first register whose end address isn't below
+ * the given address. This is the register that contains the address or the
+ * position where a register starting at this address must be inserted.
+ */
+static unsigned int reg_idx_find(
+    REG_ENTRY_T * const *regs,                  /**< register index */
+    unsigned int cnt,                           /**< register count */
+    REG_ADDR_T addr                             /**< register address */
 )
 {
-    REG_ENTRY_T **regs_it;                      /* register iterator */
+    unsigned int lo = 0;                        /* lower bound */
+    unsigned int hi = cnt;                      /* upper bound */
+    unsigned int mid;                           /* middle */
 
-    /* find last element */
-    for (regs_it = &regs; *regs_it; regs_it = &(*regs_it)->next);
+    while (lo < hi) {
+        mid = lo + ((hi - lo) >> 1);
+        if (regs[mid]->addr_end < addr) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
 
-    /* attach new register entry */
-    *regs_it = reg;
+    return lo;
 }
 
 
+#if PINKIE_CFG_REGREG_ADDR32 == 1
 /*****************************************************************************/
-/** Check if register is in range
+/** Build page table
  *
- * Warning: The result only shows the last performed register access. If
- * something in between when wrong it is skipped.
+ * Assigns every 64k address window the index range of the registers that
+ * overlap it. Registers spanning multiple windows are added to each of them.
  *
  * @retval 0 successful
- * @retval other failed
+ * @retval REGREG_RES_FULL out of pages
  */
-unsigned int reg_rw(
-    REG_ACC_T *reg_acc                          /**< register access info */
+static unsigned int reg_pt_build(
+    REGREG_PT_T *pt,                            /**< page table */
+    REG_ENTRY_T * const *regs,                  /**< register index */
+    unsigned int cnt                            /**< register count */
 )
 {
-    unsigned int res = 0;                       /* result */
-    REG_ENTRY_T *reg;                           /* register */
-    unsigned int found_flg = 0;                 /* found flag */
-    unsigned int data_len = reg_acc->data_len;  /* overall data length */
+    unsigned int pos;                           /* index position */
+    uint32_t win;                               /* address window */
+    uint32_t win_end;                           /* last address window */
+    REGREG_PT_SLOT_T *slot;                     /* page slot */
 
-    while (data_len) {
+    memset(pt, 0, sizeof(*pt));
 
-        for (reg = regs; reg; reg = reg->next) {
-            if ((reg_acc->addr >= reg->addr_beg) && (reg_acc->addr <= reg->addr_end)) {
-                found_flg = 1;
-                break;
+    if (UINT16_MAX < cnt) {
+        return REGREG_RES_FULL;
+    }
+
+    for (pos = 0; pos < cnt; pos++) {
+        win_end = regs[pos]->addr_end >> REGREG_PT_SHIFT_WIN;
+
+        for (win = regs[pos]->addr_beg >> REGREG_PT_SHIFT_WIN; win <= win_end; win++) {
+
+            /* assign page to directory entry */
+            if (!pt->dir[win / REGREG_PT_SLOTS]) {
+                if (PINKIE_CFG_REGREG_PAGES <= pt->pages_cnt) {
+                    return REGREG_RES_FULL;
+                }
+                pt->dir[win / REGREG_PT_SLOTS] = ++pt->pages_cnt;
+            }
+
+            slot = &pt->pages[pt->dir[win / REGREG_PT_SLOTS] - 1][win % REGREG_PT_SLOTS];
+            if (!slot->cnt) {
+                slot->pos = (uint16_t) pos;
             }
+            slot->cnt++;
         }
+    }
+
+    return 0;
+}
+
+
+/*****************************************************************************/
+/** Find register by page table
+ *
+ * Only the registers of the address window are searched.
+ *
+ * @returns register or NULL if address isn't mapped
+ */
+static REG_ENTRY_T * reg_pt_find(
+    const REGREG_PT_T *pt,                      /**< page table */
+    REG_ENTRY_T * const *regs,                  /**< register index */
+    REG_ADDR_T addr                             /**< register address */
+)
+{
+    uint8_t page;                               /* page number + 1 */
+    const REGREG_PT_SLOT_T *slot;               /* page slot */
+    unsigned int pos;                           /* index position */
+
+    page = pt->dir[addr >> REGREG_PT_SHIFT_DIR];
+    if (!page) {
+        return NULL;
+    }
+
+    slot = &pt->pages[page - 1][(addr >> REGREG_PT_SHIFT_WIN) % REGREG_PT_SLOTS];
+    pos = slot->pos + reg_idx_find(&regs[slot->pos], slot->cnt, addr);
+    if ((pos < (unsigned int) (slot->pos + slot->cnt)) && (regs[pos]->addr_beg <= addr)) {
+        return regs[pos];
+    }
+
+    return NULL;
+}
+#endif
+
+
+/*****************************************************************************/
+/** Static table entry count
+ */
+static unsigned int reg_tbl_cnt(
+    void
+)
+{
+    return __stop_regreg_tbl - __start_regreg_tbl;
+}
+
+
+/*****************************************************************************/
+/** Get static table entry
+ *
+ * The entry is copied to the given buffer as the table can reside in a
+ * separate address space like the AVR flash.
+ */
+static const REG_ENTRY_T * reg_tbl_get(
+    unsigned int pos,                           /**< table position */
+    REG_ENTRY_T *buf                            /**< entry buffer */
+)
+{
+    PINKIE_ARCH_ROM_READ(buf, &__start_regreg_tbl[pos], sizeof(REG_ENTRY_T));
+
+    return buf;
+}
+
+
+/*****************************************************************************/
+/** Find static table entry that overlaps the given range
+ *
+ * @returns entry copied to buffer or NULL if no entry overlaps
+ */
+static REG_ENTRY_T * reg_tbl_find(
+    REG_ADDR_T addr_beg,                        /**< start address */
+    REG_ADDR_T addr_end,                        /**< end address */
+    REG_ENTRY_T *buf                            /**< entry buffer */
+)
+{
+    unsigned int lo = 0;                        /* lower bound */
+    unsigned int hi = reg_tbl_cnt();            /* upper bound */
+    unsigned int mid;                           /* middle */
 
-        if (!found_flg) {
-            if (!(data_len - 1)) {
-                return 1;
+    /* unsorted table: linear scan */
+    if (!flg_tbl_sorted) {
+        for (; lo < hi; lo++) {
+            reg_tbl_get(lo, buf);
+            if ((buf->addr_beg <= addr_end) && (buf->addr_end >= addr_beg)) {
+                return buf;
             }
+        }
 
-            data_len--;
-            reg_acc->addr++;
-            continue;
+        return NULL;
+    }
+
+    /* sorted table: binary search */
+    while (lo < hi) {
+        mid = lo + ((hi - lo) >> 1);
+        if (reg_tbl_get(mid, buf)->addr_end < addr_beg) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
         }
+    }
+
+    if ((lo < reg_tbl_cnt()) && (reg_tbl_get(lo, buf)->addr_beg <= addr_end)) {
+        return buf;
+    }
+
+    return NULL;
+}
+
+
+#if PINKIE_CFG_REGREG_CONCURRENT == 1
+/*****************************************************************************/
+/** Initialize striped entry locks and reader slot key
+ */
+static void reg_locks_init(
+    void
+)
+{
+    unsigned int cnt;                           /* counter */
+
+    for (cnt = 0; cnt < PINKIE_CFG_REGREG_LOCKS; cnt++) {
+        pthread_mutex_init(&reg_locks[cnt].lock, NULL);
+    }
+
+    pthread_key_create(&reg_reader_key, reg_reader_release);
+}
+
+
+/*****************************************************************************/
+/** Get entry lock
+ *
+ * The lock is selected by context and start address, as static entries are
+ * only available as copies.
+ */
+static pthread_mutex_t * reg_lock_get(
+    REGREG_CTX_T *ctx,                          /**< register context */
+    REG_ENTRY_T *reg                            /**< register */
+)
+{
+    uint32_t hash;                              /* lock hash */
+
+    pthread_once(&reg_locks_once, reg_locks_init);
+
+    hash = ((uint32_t) ((uintptr_t) ctx >> 4) ^ reg->addr_beg) * 2654435761UL;
+
+    return &reg_locks[(hash >> 16) % PINKIE_CFG_REGREG_LOCKS].lock;
+}
+
+
+/*****************************************************************************/
+/** Release reader slot at thread exit
+ */
+static void reg_reader_release(
+    void *arg                                   /**< reader slot + 1 */
+)
+{
+    REG_READER_T *reader = &reg_readers[(uintptr_t) arg - 1]; /* reader slot */
+
+    __atomic_store_n(&reader->epoch, 0, __ATOMIC_RELEASE);
+    __atomic_store_n(&reader->flg_used, 0, __ATOMIC_RELEASE);
+}
+
+
+/*****************************************************************************/
+/** Acquire free reader slot
+ *
+ * The slot is released by the thread key destructor when the thread exits,
+ * so short-lived threads don't use up the slots.
+ *
+ * @returns slot index or PINKIE_CFG_REGREG_READERS if all slots are in use
+ */
+static int reg_reader_acquire(
+    void
+)
+{
+    unsigned int cnt;                           /* counter */
+    uint8_t flg_used;                           /* expected used flag */
 
-        /* calculate address offset */
-        reg_acc->addr_ofs = reg_acc->addr - reg->addr_beg;
+    pthread_once(&reg_locks_once, reg_locks_init);
 
-        /* calculate data length depending on overall requested reg_acc->data_len */
-        reg_acc->data_len = reg->addr_end - reg->addr_beg + 1;
-        if (data_len < reg_acc->data_len) {
-            reg_acc->data_len = data_len;
+    for (cnt = 0; cnt < PINKIE_CFG_REGREG_READERS; cnt++) {
+        flg_used = 0;
+        if (__atomic_compare_exchange_n(&reg_readers[cnt].flg_used, &flg_used, 1, 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+            pthread_setspecific(reg_reader_key, (void *) (uintptr_t) (cnt + 1));
+            return (int) cnt;
         }
-        data_len -= reg_acc->data_len;
+    }
 
-        /* if register has a callback, call it once */
-        if (reg->cb) {
-            res = reg->cb(reg, reg_acc);
-            if (REGREG_RES_PROCEED != res) {
-                continue;
+    return PINKIE_CFG_REGREG_READERS;
+}
+
+
+/*****************************************************************************/
+/** Enter lock-free read section
+ *
+ * Marks the thread as active in the current epoch and returns the published
+ * snapshot. If more than PINKIE_CFG_REGREG_READERS threads are active at the
+ * same time, the others fall back to the writer lock.
+ */
+static REGREG_SNAP_T * reg_read_enter(
+    REGREG_CTX_T *ctx                           /**< register context */
+)
+{
+    /* assign reader slot on first use */
+    if (0 > reg_reader_slot) {
+        reg_reader_slot = reg_reader_acquire();
+    }
+
+    if (PINKIE_CFG_REGREG_READERS <= reg_reader_slot) {
+        pthread_mutex_lock(&reg_wr_lock);
+    } else {
+        __atomic_store_n(&reg_readers[reg_reader_slot].epoch, __atomic_load_n(&reg_epoch, __ATOMIC_SEQ_CST), __ATOMIC_SEQ_CST);
+    }
+
+    return __atomic_load_n(&ctx->snap, __ATOMIC_SEQ_CST);
+}
+
+
+/*****************************************************************************/
+/** Leave lock-free read section
+ */
+static void reg_read_leave(
+    void
+)
+{
+    if (PINKIE_CFG_REGREG_READERS <= reg_reader_slot) {
+        pthread_mutex_unlock(&reg_wr_lock);
+    } else {
+        __atomic_store_n(&reg_readers[reg_reader_slot].epoch, 0, __ATOMIC_RELEASE);
+    }
+}
+
+
+/*****************************************************************************/
+/** Publish index snapshot
+ *
+ * Copies the context index to the snapshot and replaces the published one.
+ * The old snapshot is freed after every reader left the previous epoch. Must
+ * be called with the writer lock held.
+ */
+static void reg_snap_publish(
+    REGREG_CTX_T *ctx,                          /**< register context */
+    REGREG_SNAP_T *snap                         /**< new snapshot */
+)
+{
+    REGREG_SNAP_T *snap_old;                    /* old snapshot */
+    uint64_t epoch;                             /* new epoch */
+    unsigned int cnt;                           /* counter */
+    uint64_t epoch_reader;                      /* reader epoch */
+
+    snap->cnt = ctx->regs_cnt;
+    memcpy(snap->regs, ctx->regs, ctx->regs_cnt * sizeof(snap->regs[0]));
+#if PINKIE_CFG_REGREG_ADDR32 == 1
+    snap->pt = ctx->pt;
+#endif
+
+    snap_old = __atomic_exchange_n(&ctx->snap, snap, __ATOMIC_SEQ_CST);
+    epoch = __atomic_add_fetch(&reg_epoch, 1, __ATOMIC_SEQ_CST);
+
+    /* wait for readers that may still use the old snapshot */
+    for (cnt = 0; cnt < PINKIE_CFG_REGREG_READERS; cnt++) {
+        for (;;) {
+            epoch_reader = __atomic_load_n(&reg_readers[cnt].epoch, __ATOMIC_SEQ_CST);
+            if ((!epoch_reader) || (epoch_reader >= epoch)) {
+                break;
             }
+            sched_yield();
         }
+    }
 
-        /* read or write data to specific data ptr */
-        if (reg_acc->write_flg) {
-            memcpy(&((uint8_t *) reg->data)[reg_acc->addr_ofs], reg_acc->data.read_from, reg_acc->data_len);
-        } else {
-            memcpy(reg_acc->data.write_to, &((uint8_t *) reg->data)[reg_acc->addr_ofs], reg_acc->data_len);
+    free(snap_old);
+}
+#endif
+
+
+/*****************************************************************************/
+/** Initialize RegReg
+ *
+ * Enables the binary search if the static register table is sorted, which
+ * the build does with regreg_tbl.py. Otherwise, e.g. if the ELF file wasn't
+ * post-processed, every entry is checked for overlaps with its successors.
+ *
+ * @retval 0 successful
+ * @retval REGREG_RES_OVERLAP static registers overlap
+ */
+unsigned int reg_init(
+    void
+)
+{
+    unsigned int cnt;                           /* counter */
+    unsigned int cnt_cmp;                       /* compare counter */
+    REG_ENTRY_T prev;                           /* previous entry */
+    REG_ENTRY_T cur;                            /* current entry */
+
+    /* check if table is sorted */
+    flg_tbl_sorted = 1;
+    for (cnt = 1; cnt < reg_tbl_cnt(); cnt++) {
+        reg_tbl_get(cnt - 1, &prev);
+        reg_tbl_get(cnt, &cur);
+
+        if (prev.addr_end >= cur.addr_beg) {
+            flg_tbl_sorted = 0;
+            break;
         }
+    }
+
+    if (flg_tbl_sorted) {
+        return 0;
+    }
+
+    /* unsorted table: compare every entry with its successors */
+    for (cnt = 0; cnt < reg_tbl_cnt(); cnt++) {
+        reg_tbl_get(cnt, &prev);
 
-        /* correct result if necessary */
-        if (REGREG_RES_PROCEED == res) {
-            res = 0;
+        for (cnt_cmp = cnt + 1; cnt_cmp < reg_tbl_cnt(); cnt_cmp++) {
+            reg_tbl_get(cnt_cmp, &cur);
+
+            if ((prev.addr_beg <= cur.addr_end) && (prev.addr_end >= cur.addr_beg)) {
+                return REGREG_RES_OVERLAP;
+            }
         }
     }
 
-    return res;
+    return 0;
+}
+
+
+/*****************************************************************************/
+/** Initialize register context
+ *
+ * The index storage must stay valid as long as the context is used. The
+ * context doesn't include the static register table.
+ */
+void reg_ctx_init(
+    REGREG_CTX_T *ctx,                          /**< register context */
+    REG_ENTRY_T **regs,                         /**< register index storage */
+    unsigned int regs_max,                      /**< register index size */
+    REG_ANN_CB_T ann,                           /**< announce hook (optional) */
+    void *priv                                  /**< user data */
+)
+{
+    ctx->regs = regs;
+    ctx->regs_max = regs_max;
+    ctx->regs_cnt = 0;
+    ctx->flg_tbl = 0;
+    ctx->ann = ann;
+    ctx->priv = priv;
+
+#if PINKIE_CFG_REGREG_ADDR32 == 1
+    memset(&ctx->pt, 0, sizeof(ctx->pt));
+#endif
+
+#if PINKIE_CFG_REGREG_CONCURRENT == 1
+    ctx->snap = NULL;
+#endif
+}
+
+
+/*****************************************************************************/
+/** Insert register into context index
+ *
+ * @retval 0 successful
+ * @retval REGREG_RES_OVERLAP range is invalid or overlaps an existing register
+ * @retval REGREG_RES_FULL register index or page table is full
+ */
+static unsigned int reg_idx_add(
+    REGREG_CTX_T *ctx,                          /**< register context */
+    REG_ENTRY_T *reg                            /**< register entry pointer */
+)
+{
+    unsigned int pos;                           /* index position */
+    REG_ENTRY_T buf;                            /* static entry buffer */
+#if PINKIE_CFG_REGREG_ADDR32 == 1
+    unsigned int res;                           /* result */
+#endif
+
+    /* check range */
+    if (reg->addr_beg > reg->addr_end) {
+        return REGREG_RES_OVERLAP;
+    }
+
+    /* check static registers for overlap */
+    if ((ctx->flg_tbl) && (reg_tbl_find(reg->addr_beg, reg->addr_end, &buf))) {
+        return REGREG_RES_OVERLAP;
+    }
+
+    /* find insert position and check neighbour for overlap */
+    pos = reg_idx_find(ctx->regs, ctx->regs_cnt, reg->addr_beg);
+    if ((pos < ctx->regs_cnt) && (ctx->regs[pos]->addr_beg <= reg->addr_end)) {
+        return REGREG_RES_OVERLAP;
+    }
+
+    /* check index size */
+    if (ctx->regs_max <= ctx->regs_cnt) {
+        return REGREG_RES_FULL;
+    }
+
+    /* insert register entry */
+    memmove(&ctx->regs[pos + 1], &ctx->regs[pos], (ctx->regs_cnt - pos) * sizeof(ctx->regs[0]));
+    ctx->regs[pos] = reg;
+    ctx->regs_cnt++;
+
+#if PINKIE_CFG_REGREG_ADDR32 == 1
+    /* update page table, remove register again if it doesn't fit */
+    res = reg_pt_build(&ctx->pt, ctx->regs, ctx->regs_cnt);
+    if (res) {
+        ctx->regs_cnt--;
+        memmove(&ctx->regs[pos], &ctx->regs[pos + 1], (ctx->regs_cnt - pos) * sizeof(ctx->regs[0]));
+        reg_pt_build(&ctx->pt, ctx->regs, ctx->regs_cnt);
+        return res;
+    }
+#endif
+
+    return 0;
+}
+
+
+/*****************************************************************************/
+/** Add a register handler to context
+ *
+ * @retval 0 successful
+ * @retval REGREG_RES_OVERLAP range is invalid or overlaps an existing register
+ * @retval REGREG_RES_FULL register index is full
+ */
+unsigned int reg_ctx_add(
+    REGREG_CTX_T *ctx,                          /**< register context */
+    REG_ENTRY_T *reg                            /**< register entry pointer */
+)
+{
+#if PINKIE_CFG_REGREG_CONCURRENT == 1
+    unsigned int res;                           /* result */
+    REGREG_SNAP_T *snap;                        /* new snapshot */
+
+    pthread_mutex_lock(&reg_wr_lock);
+
+    /* allocate snapshot first, so a published index can't fail afterwards */
+    snap = malloc(sizeof(REGREG_SNAP_T) + ((ctx->regs_cnt + 1) * sizeof(snap->regs[0])));
+    if (!snap) {
+        pthread_mutex_unlock(&reg_wr_lock);
+        return REGREG_RES_FULL;
+    }
+
+    res = reg_idx_add(ctx, reg);
+    if (res) {
+        free(snap);
+    } else {
+        reg_snap_publish(ctx, snap);
+    }
+
+    pthread_mutex_unlock(&reg_wr_lock);
+
+    return res;
+#else
+    return reg_idx_add(ctx, reg);
+#endif
+}
+
+
+/*****************************************************************************/
+/** Get default register context
+ */
+REGREG_CTX_T * reg_ctx_dfl_get(
+    void
+)
+{
+    return &reg_ctx_dfl;
+}
+
+
+/*****************************************************************************/
+/** Add a register handler to default context
+ */
+unsigned int reg_add(
+    REG_ENTRY_T *reg                            /**< register entry pointer */
+)
+{
+    return reg_ctx_add(&reg_ctx_dfl, reg);
+}
+
+
+/*****************************************************************************/
+/** Find register entry in context
+ *
+ * Static entries are copied to the given buffer.
+ *
+ * @returns register entry or NULL if address isn't mapped
+ */
+REG_ENTRY_T * reg_ctx_find(
+    REGREG_CTX_T *ctx,                          /**< register context */
+    REG_ADDR_T addr,                            /**< register address */
+    REG_ENTRY_T *buf                            /**< static entry buffer */
+)
+{
+#if PINKIE_CFG_REGREG_ADDR32 == 0
+    unsigned int pos;                           /* index position */
+#endif
+    REG_ENTRY_T *reg = NULL;                    /* register */
+
+#if PINKIE_CFG_REGREG_CONCURRENT == 1
+    REGREG_SNAP_T *snap;                        /* index snapshot */
+
+    snap = reg_read_enter(ctx);
+    if (snap) {
+#  if PINKIE_CFG_REGREG_ADDR32 == 1
+        reg = reg_pt_find(&snap->pt, snap->regs, addr);
+#  else
+        pos = reg_idx_find(snap->regs, snap->cnt, addr);
+        if ((pos < snap->cnt) && (snap->regs[pos]->addr_beg <= addr)) {
+            reg = snap->regs[pos];
+        }
+#  endif
+    }
+    reg_read_leave();
+#elif PINKIE_CFG_REGREG_ADDR32 == 1
+    reg = reg_pt_find(&ctx->pt, ctx->regs, addr);
+#else
+    pos = reg_idx_find(ctx->regs, ctx->regs_cnt, addr);
+    if ((pos < ctx->regs_cnt) && (ctx->regs[pos]->addr_beg <= addr)) {
+        reg = ctx->regs[pos];
+    }
+#endif
+
+    if (reg) {
+        return reg;
+    }
+
+    if (!ctx->flg_tbl) {
+        return NULL;
+    }
+
+    return reg_tbl_find(addr, addr, buf);
+}
+
+
+/*****************************************************************************/
+/** Find register entry in default context
+ */
+REG_ENTRY_T * reg_find(
+    REG_ADDR_T addr,                            /**< register address */
+    REG_ENTRY_T *buf                            /**< static entry buffer */
+)
+{
+    return reg_ctx_find(&reg_ctx_dfl, addr, buf);
+}
+
+
+/*****************************************************************************/
+/** Get register entry of context by position
+ *
+ * Iterates the dynamic entries in address order followed by the static
+ * table. Static entries are copied to the given buffer. Entries can move if
+ * registers are added while iterating.
+ *
+ * @returns register entry or NULL if position is behind the last entry
+ */
+REG_ENTRY_T * reg_ctx_entry_get(
+    REGREG_CTX_T *ctx,                          /**< register context */
+    unsigned int pos,                           /**< entry position */
+    REG_ENTRY_T *buf                            /**< static entry buffer */
+)
+{
+#if PINKIE_CFG_REGREG_CONCURRENT == 1
+    REG_ENTRY_T *reg = NULL;                    /* register */
+    REGREG_SNAP_T *snap;                        /* index snapshot */
+    unsigned int cnt = 0;                       /* dynamic entry count */
+
+    snap = reg_read_enter(ctx);
+    if (snap) {
+        cnt = snap->cnt;
+        if (pos < cnt) {
+            reg = snap->regs[pos];
+        }
+    }
+    reg_read_leave();
+
+    if (reg) {
+        return reg;
+    }
+    pos -= cnt;
+#else
+    if (pos < ctx->regs_cnt) {
+        return ctx->regs[pos];
+    }
+    pos -= ctx->regs_cnt;
+#endif
+
+    if ((!ctx->flg_tbl) || (pos >= reg_tbl_cnt())) {
+        return NULL;
+    }
+
+    reg_tbl_get(pos, buf);
+
+    return buf;
+}
+
+
+#if PINKIE_CFG_REGREG_STATS == 1
+/*****************************************************************************/
+/** Update register callback statistics
+ */
+static void reg_stat_time(
+    REGREG_STAT_T *stat,                        /**< register statistics */
+    uint32_t time,                              /**< callback time */
+    unsigned int res                            /**< callback result */
+)
+{
+#if PINKIE_CFG_REGREG_CONCURRENT == 1
+    uint16_t time_max;                          /* current max callback time */
+#endif
+
+    if (REGREG_RES_BUSY == res) {
+        REG_STAT_INC(stat->cnt_busy);
+    }
+
+    if (UINT16_MAX < time) {
+        time = UINT16_MAX;
+    }
+
+#if PINKIE_CFG_REGREG_CONCURRENT == 1
+    /* entry locks are per context, so the same entry can finish in parallel,
+     * a failed exchange reloads the max raised by the other thread */
+    time_max = __atomic_load_n(&stat->time_max, __ATOMIC_RELAXED);
+    while (time_max < time) {
+        if (__atomic_compare_exchange_n(&stat->time_max, &time_max, (uint16_t) time, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            break;
+        }
+    }
+#else
+    if (stat->time_max < time) {
+        stat->time_max = (uint16_t) time;
+    }
+#endif
+
+    REG_STAT_ADD(stat->time_sum, time);
+}
+#endif
+
+
+/*****************************************************************************/
+/** Call register callback and copy data
+ *
+ * The callback can reduce reg_acc->data_len if it handled less data than
+ * requested.
+ *
+ * @retval 0 successful
+ * @retval other failed
+ */
+static unsigned int reg_rw_cb(
+    REG_ENTRY_T *reg,                           /**< register */
+    REG_ACC_T *reg_acc                          /**< register access info */
+)
+{
+    unsigned int res = REGREG_RES_PROCEED;      /* result */
+#if PINKIE_CFG_REGREG_STATS == 1
+    uint32_t ts;                                /* callback start time */
+#endif
+
+    /* calculate address offset */
+    reg_acc->addr_ofs = reg_acc->addr - reg->addr_beg;
+
+    /* if register has a callback, call it once */
+    if (reg->cb) {
+#if PINKIE_CFG_REGREG_STATS == 1
+        if (reg->stat) {
+            ts = PINKIE_CFG_REGREG_STATS_TIME();
+            res = reg->cb(reg, reg_acc);
+            reg_stat_time(reg->stat, PINKIE_CFG_REGREG_STATS_TIME() - ts, res);
+        } else {
+            res = reg->cb(reg, reg_acc);
+        }
+#else
+        res = reg->cb(reg, reg_acc);
+#endif
+        if (REGREG_RES_PROCEED != res) {
+            return res;
+        }
+    }
+
+    /* read or write data to specific data ptr */
+    if (reg_acc->write_flg) {
+        memcpy(&((uint8_t *) reg->data)[reg_acc->addr_ofs], reg_acc->data.read_from, reg_acc->data_len);
+
+#if PINKIE_CFG_REGREG_NVS == 1
+        /* schedule NVS write-back of persistent data */
+        if (reg->flg & REGREG_FLG_NVS) {
+            reg_nvs_mark(&((uint8_t *) reg->data)[reg_acc->addr_ofs], reg_acc->data_len);
+        }
+#endif
+    } else {
+        memcpy(reg_acc->data.write_to, &((uint8_t *) reg->data)[reg_acc->addr_ofs], reg_acc->data_len);
+    }
+
+    return 0;
+}
+
+
+#if PINKIE_CFG_REGREG_CACHE == 1
+/*****************************************************************************/
+/** Fill register value cache
+ *
+ * Reads the whole register range into the cache. The callback can return less
+ * data than requested, so it is called until the range is complete. Returning
+ * no data at all fails the fill.
+ *
+ * @retval 0 successful
+ * @retval other failed
+ */
+static unsigned int reg_cache_fill(
+    REG_ENTRY_T *reg,                           /**< register */
+    REG_ACC_T *reg_acc                          /**< register access info */
+)
+{
+    unsigned int res;                           /* result */
+    unsigned int len;                           /* remaining length */
+    REG_ACC_T acc = *reg_acc;                   /* fill access */
+
+    acc.addr = reg->addr_beg;
+    acc.data.write_to = reg->cache->data;
+    len = (unsigned int) (reg->addr_end - reg->addr_beg) + 1;
+
+    while (len) {
+        acc.data_len = len;
+
+        res = reg_rw_cb(reg, &acc);
+        if (res) {
+            return res;
+        }
+
+        /* a callback that handles no data would never complete the range */
+        if (!acc.data_len) {
+            return 1;
+        }
+
+        len -= acc.data_len;
+        acc.addr += acc.data_len;
+        acc.data.write_to += acc.data_len;
+    }
+
+    reg->cache->ts = (uint32_t) pinkie_timer_get();
+    reg->cache->flg_valid = 1;
+
+    return 0;
+}
+#endif
+
+
+#if PINKIE_CFG_REGREG_CACHE == 1
+/*****************************************************************************/
+/** Read register through value cache
+ *
+ * @retval 0 successful
+ * @retval other failed
+ */
+static unsigned int reg_cache_read(
+    REG_ENTRY_T *reg,                           /**< register */
+    REG_ACC_T *reg_acc                          /**< register access info */
+)
+{
+    unsigned int res;                           /* result */
+
+    /* refill stale cache */
+    if ((!reg->cache->flg_valid) ||
+        (((uint32_t) pinkie_timer_get() - reg->cache->ts) >= reg->cache->ttl_ms)) {
+        REG_STAT_INC(cache_stat.cnt_miss);
+
+        res = reg_cache_fill(reg, reg_acc);
+        if (res) {
+            reg->cache->flg_valid = 0;
+            return res;
+        }
+    } else {
+        REG_STAT_INC(cache_stat.cnt_hit);
+    }
+
+    reg_acc->addr_ofs = reg_acc->addr - reg->addr_beg;
+    memcpy(reg_acc->data.write_to, &reg->cache->data[reg_acc->addr_ofs], reg_acc->data_len);
+
+    return 0;
+}
+#endif
+
+
+#if PINKIE_CFG_REGREG_PEND_CNT > 0
+/*****************************************************************************/
+/** Check for pending writes to a register
+ *
+ * @returns 1 if the register has pending writes, 0 otherwise
+ */
+static unsigned int reg_pend_find(
+    REGREG_CTX_T *ctx,                          /**< register context */
+    REG_ENTRY_T *reg                            /**< register */
+)
+{
+    unsigned int cnt;                           /* counter */
+    REG_PEND_T *pend;                           /* pending write */
+
+    for (cnt = 0; cnt < pends_cnt; cnt++) {
+        pend = &pends[(pends_rd + cnt) % PINKIE_CFG_REGREG_PEND_CNT];
+        if ((pend->ctx == ctx) && (pend->addr >= reg->addr_beg) && (pend->addr <= reg->addr_end)) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+
+/*****************************************************************************/
+/** Queue a write for later completion
+ *
+ * @retval REGREG_RES_PENDING write queued
+ * @retval REGREG_RES_BUSY queue full or write too long
+ */
+static unsigned int reg_pend_add(
+    REGREG_CTX_T *ctx,                          /**< register context */
+    REG_ACC_T *reg_acc                          /**< register access info */
+)
+{
+    REG_PEND_T *pend;                           /* pending write */
+
+    if ((PINKIE_CFG_REGREG_PEND_CNT <= pends_cnt) || (PINKIE_CFG_REGREG_PEND_LEN < reg_acc->data_len)) {
+        pend_stat.cnt_full++;
+        return REGREG_RES_BUSY;
+    }
+
+    pend = &pends[(pends_rd + pends_cnt) % PINKIE_CFG_REGREG_PEND_CNT];
+    pend->ctx = ctx;
+    pend->addr = reg_acc->addr;
+    pend->len = reg_acc->data_len;
+    pend->ofs = 0;
+    memcpy(pend->data, reg_acc->data.read_from, reg_acc->data_len);
+    pends_cnt++;
+
+    return REGREG_RES_PENDING;
+}
+#endif
+
+
+/*****************************************************************************/
+/** Access a single register entry
+ *
+ * The access must be located inside the register entry. The callback can
+ * reduce reg_acc->data_len if it handled less data than requested.
+ *
+ * @retval 0 successful
+ * @retval REGREG_RES_PENDING write queued for later completion
+ * @retval other failed
+ */
+static unsigned int reg_rw_entry(
+    REGREG_CTX_T *ctx,                          /**< register context */
+    REG_ENTRY_T *reg,                           /**< register */
+    REG_ACC_T *reg_acc                          /**< register access info */
+)
+{
+#if PINKIE_CFG_REGREG_PEND_CNT > 0
+    unsigned int res;                           /* result */
+#else
+    PINKIE_UNUSED(ctx);
+#endif
+
+#if PINKIE_CFG_REGREG_STATS == 1
+    if (reg->stat) {
+        if (reg_acc->write_flg) {
+            REG_STAT_INC(reg->stat->cnt_wr);
+        } else {
+            REG_STAT_INC(reg->stat->cnt_rd);
+        }
+    }
+#endif
+
+#if PINKIE_CFG_REGREG_CACHE == 1
+    if (reg->cache) {
+
+        /* writes bypass the cache and invalidate it */
+        if (!reg_acc->write_flg) {
+            return reg_cache_read(reg, reg_acc);
+        }
+
+        reg->cache->flg_valid = 0;
+    }
+#endif
+
+#if PINKIE_CFG_REGREG_PEND_CNT > 0
+    if (reg_acc->write_flg) {
+
+        /* keep write order behind already pending writes */
+        if (reg_pend_find(ctx, reg)) {
+            return reg_pend_add(ctx, reg_acc);
+        }
+
+        res = reg_rw_cb(reg, reg_acc);
+        if (REGREG_RES_BUSY == res) {
+            return reg_pend_add(ctx, reg_acc);
+        }
+
+        return res;
+    }
+#endif
+
+    return reg_rw_cb(reg, reg_acc);
+}
+
+
+/*****************************************************************************/
+/** Access a range inside a found register entry
+ *
+ * The callback can handle less data than requested, so the access is
+ * continued until the range is complete. A callback that handles no data at
+ * all fails the access.
+ *
+ * @retval 0 successful
+ * @retval REGREG_RES_PENDING write queued for later completion
+ * @retval other failed
+ */
+static unsigned int reg_rw_range(
+    REGREG_CTX_T *ctx,                          /**< register context */
+    REG_ENTRY_T *reg,                           /**< register */
+    REG_ACC_T *reg_acc                          /**< register access info */
+)
+{
+    unsigned int res = 1;                       /* result */
+    unsigned int len = reg_acc->data_len;       /* remaining data length */
+    REG_ACC_T acc = *reg_acc;                   /* partial access */
+#if PINKIE_CFG_REGREG_CONCURRENT == 1
+    pthread_mutex_t *lock = NULL;               /* entry lock */
+
+    /* plain data entries are only copied, they don't need serialization */
+    if (REG_LOCK_NEEDED(reg)) {
+        lock = reg_lock_get(ctx, reg);
+    }
+#endif
+
+    while (len) {
+        acc.data_len = (uint16_t) len;
+
+#if PINKIE_CFG_REGREG_CONCURRENT == 1
+        if (lock) {
+            pthread_mutex_lock(lock);
+            res = reg_rw_entry(ctx, reg, &acc);
+            pthread_mutex_unlock(lock);
+        } else {
+            res = reg_rw_entry(ctx, reg, &acc);
+        }
+#else
+        res = reg_rw_entry(ctx, reg, &acc);
+#endif
+
+        if (!acc.data_len) {
+            return 1;
+        }
+
+        len -= acc.data_len;
+        acc.addr += acc.data_len;
+        acc.data.read_from += acc.data_len;
+    }
+
+    return res;
+}
+
+
+/*****************************************************************************/
+/** Check if register is in range
+ *
+ * The access can span multiple registers. Unmapped addresses are skipped.
+ * The address, data pointer and length in reg_acc are restored after the
+ * access.
+ *
+ * Warning: The result only shows the last performed register access. If
+ * something in between when wrong it is skipped.
+ *
+ * @retval 0 successful
+ * @retval other failed
+ */
+unsigned int reg_ctx_rw(
+    REGREG_CTX_T *ctx,                          /**< register context */
+    REG_ACC_T *reg_acc                          /**< register access info */
+)
+{
+    unsigned int res = 1;                       /* result */
+    REG_ENTRY_T *reg;                           /* register */
+    REG_ENTRY_T buf;                            /* static entry buffer */
+    REG_ADDR_T addr = reg_acc->addr;            /* start address */
+    const uint8_t *data = reg_acc->data.read_from; /* data pointer */
+    uint16_t len = reg_acc->data_len;           /* requested data length */
+    unsigned int data_len = len;                /* remaining data length */
+
+#if PINKIE_CFG_REGREG_TXN_LEN > 0
+    /* stage writes of an active transaction */
+    if (reg_acc->write_flg) {
+        res = reg_txn_stage(ctx, reg_acc);
+        if (REGREG_RES_PROCEED != res) {
+            return res;
+        }
+        res = 1;
+    }
+#endif
+
+    while (data_len) {
+
+        reg = reg_ctx_find(ctx, reg_acc->addr, &buf);
+        if (!reg) {
+            res = 1;
+            reg_acc->data_len = 1;
+        } else {
+
+            /* limit data length to register end */
+            reg_acc->data_len = (uint16_t) data_len;
+            if ((REG_ADDR_T) (reg->addr_end - reg_acc->addr) < (data_len - 1)) {
+                reg_acc->data_len = (uint16_t) (reg->addr_end - reg_acc->addr + 1);
+            }
+
+            res = reg_rw_range(ctx, reg, reg_acc);
+        }
+
+        /* continue behind the handled data */
+        data_len -= reg_acc->data_len;
+        reg_acc->addr += reg_acc->data_len;
+        reg_acc->data.read_from += reg_acc->data_len;
+    }
+
+    /* restore access info */
+    reg_acc->addr = addr;
+    reg_acc->data.read_from = data;
+    reg_acc->data_len = len;
+
+    return res;
+}
+
+
+/*****************************************************************************/
+/** Register access in default context
+ */
+unsigned int reg_rw(
+    REG_ACC_T *reg_acc                          /**< register access info */
+)
+{
+    return reg_ctx_rw(&reg_ctx_dfl, reg_acc);
+}
+
+
+/*****************************************************************************/
+/** Store vectored access result
+ *
+ * @returns 1 if the access failed, 0 otherwise
+ */
+static unsigned int reg_vec_res(
+    uint8_t *res_list,                          /**< result list (optional) */
+    unsigned int pos,                           /**< list position */
+    unsigned int res                            /**< access result */
+)
+{
+    if (res_list) {
+        res_list[pos] = (uint8_t) res;
+    }
+
+    return (res) ? 1 : 0;
+}
+
+
+/*****************************************************************************/
+/** Vectored register access
+ *
+ * Resolves a list of register accesses in chunks of PINKIE_CFG_REGREG_VEC_CNT
+ * accesses. Inside a chunk the accesses of one direction to the same register
+ * entry are grouped, so the entry is looked up and its callback is called
+ * once per group. The group data is collected in a bounce buffer of
+ * PINKIE_CFG_REGREG_VEC_BUF bytes. Only adjacent or overlapping accesses are
+ * merged, so the callback never sees bytes that weren't requested, e.g. a
+ * read of a register with side effects. A later write of the same byte wins.
+ *
+ * To keep the access order, a group ends at the next access to the entry that
+ * can't join, like one of the other direction. Writes that can't join block
+ * later writes to the same bytes. Accesses that span several entries, hit
+ * unmapped addresses or exceed the bounce buffer are passed to reg_ctx_rw().
+ *
+ * @returns count of failed accesses
+ */
+unsigned int reg_ctx_rw_vec(
+    REGREG_CTX_T *ctx,                          /**< register context */
+    REG_ACC_T *reg_accs,                        /**< register access list */
+    unsigned int cnt,                           /**< access count */
+    uint8_t *res_list                           /**< result list (optional) */
+)
+{
+    unsigned int cnt_err = 0;                   /* error counter */
+    unsigned int base;                          /* chunk start */
+    unsigned int num;                           /* chunk length */
+    unsigned int pos;                           /* chunk position */
+    unsigned int idx;                           /* candidate position */
+    unsigned int flg_grow;                      /* group grew flag */
+    unsigned int flg_blk;                       /* blocked write range flag */
+    unsigned int res;                           /* access result */
+    REG_ADDR_T beg;                             /* group start address */
+    REG_ADDR_T end;                             /* group end address */
+    REG_ADDR_T cand_beg;                        /* candidate start address */
+    REG_ADDR_T cand_end;                        /* candidate end address */
+    REG_ADDR_T blk_beg = 0;                     /* blocked write start address */
+    REG_ADDR_T blk_end = 0;                     /* blocked write end address */
+    REG_ENTRY_T *reg;                           /* register */
+    REG_ENTRY_T buf;                            /* static entry buffer */
+    REG_ACC_T *cand;                            /* candidate access */
+    REG_ACC_T reg_acc;                          /* group access */
+    uint8_t state[PINKIE_CFG_REGREG_VEC_CNT];   /* access states */
+    uint8_t bounce[PINKIE_CFG_REGREG_VEC_BUF];  /* group data */
+
+    for (base = 0; base < cnt; base += num) {
+
+        num = cnt - base;
+        if (PINKIE_CFG_REGREG_VEC_CNT < num) {
+            num = PINKIE_CFG_REGREG_VEC_CNT;
+        }
+        memset(state, REG_VEC_OPEN, num);
+
+        for (pos = 0; pos < num; pos++) {
+
+            if (REG_VEC_DONE == state[pos]) {
+                continue;
+            }
+
+            reg_acc = reg_accs[base + pos];
+            reg = reg_ctx_find(ctx, reg_acc.addr, &buf);
+
+            /* pass on accesses that can't be grouped */
+            if ((!reg) || (!reg_acc.data_len) || (PINKIE_CFG_REGREG_VEC_BUF < reg_acc.data_len) ||
+                ((REG_ADDR_T) (reg->addr_end - reg_acc.addr) < (REG_ADDR_T) (reg_acc.data_len - 1))) {
+                cnt_err += reg_vec_res(res_list, base + pos, reg_ctx_rw(ctx, &reg_acc));
+                continue;
+            }
+
+            state[pos] = REG_VEC_GRP;
+            beg = reg_acc.addr;
+            end = (REG_ADDR_T) (reg_acc.addr + reg_acc.data_len - 1);
+
+            /* collect group, repeated as a joined access can close a gap */
+            do {
+                flg_grow = 0;
+                flg_blk = 0;
+
+                for (idx = pos + 1; idx < num; idx++) {
+
+                    cand = &reg_accs[base + idx];
+                    if ((REG_VEC_OPEN != state[idx]) || (!cand->data_len)) {
+                        continue;
+                    }
+
+                    cand_beg = cand->addr;
+                    cand_end = (REG_ADDR_T) (cand->addr + cand->data_len - 1);
+
+                    /* accesses to other entries don't affect the order */
+                    if ((cand_end >= cand_beg) && ((cand_end < reg->addr_beg) || (cand_beg > reg->addr_end))) {
+                        continue;
+                    }
+
+                    /* group ends at an access to the entry that can't join */
+                    if ((cand->write_flg != reg_acc.write_flg) || (cand_end < cand_beg) ||
+                        (cand_beg < reg->addr_beg) || (cand_end > reg->addr_end)) {
+                        break;
+                    }
+
+                    /* writes must not overtake a write to the same bytes */
+                    if ((flg_blk) && (cand_beg <= blk_end) && (cand_end >= blk_beg)) {
+                        break;
+                    }
+
+                    if ((((cand_end > end) ? cand_end : end) - ((cand_beg < beg) ? cand_beg : beg) >= PINKIE_CFG_REGREG_VEC_BUF) ||
+                        ((cand_beg > end) && ((REG_ADDR_T) (cand_beg - end) > 1)) ||
+                        ((cand_end < beg) && ((REG_ADDR_T) (beg - cand_end) > 1))) {
+
+                        if (reg_acc.write_flg) {
+                            blk_beg = (!flg_blk || (cand_beg < blk_beg)) ? cand_beg : blk_beg;
+                            blk_end = (!flg_blk || (cand_end > blk_end)) ? cand_end : blk_end;
+                            flg_blk = 1;
+                        }
+                        continue;
+                    }
+
+                    state[idx] = REG_VEC_GRP;
+                    beg = (cand_beg < beg) ? cand_beg : beg;
+                    end = (cand_end > end) ? cand_end : end;
+                    flg_grow = 1;
+                }
+            } while (flg_grow);
+
+            /* access group range through the bounce buffer */
+            reg_acc.addr = beg;
+            reg_acc.data_len = (uint16_t) (end - beg + 1);
+            reg_acc.data.write_to = bounce;
+
+            if (reg_acc.write_flg) {
+                for (idx = pos; idx < num; idx++) {
+                    if (REG_VEC_GRP == state[idx]) {
+                        cand = &reg_accs[base + idx];
+                        memcpy(&bounce[cand->addr - beg], cand->data.read_from, cand->data_len);
+                    }
+                }
+
+#if PINKIE_CFG_REGREG_TXN_LEN > 0
+                res = reg_txn_stage(ctx, &reg_acc);
+                if (REGREG_RES_PROCEED == res) {
+                    res = reg_rw_range(ctx, reg, &reg_acc);
+                }
+#else
+                res = reg_rw_range(ctx, reg, &reg_acc);
+#endif
+            } else {
+                res = reg_rw_range(ctx, reg, &reg_acc);
+            }
+
+            /* distribute data and result to the group */
+            for (idx = pos; idx < num; idx++) {
+                if (REG_VEC_GRP != state[idx]) {
+                    continue;
+                }
+
+                cand = &reg_accs[base + idx];
+                if ((!res) && (!cand->write_flg)) {
+                    memcpy(cand->data.write_to, &bounce[cand->addr - beg], cand->data_len);
+                }
+
+                cnt_err += reg_vec_res(res_list, base + idx, res);
+                state[idx] = REG_VEC_DONE;
+            }
+        }
+    }
+
+    return cnt_err;
+}
+
+
+/*****************************************************************************/
+/** Vectored register access in default context
+ */
+unsigned int reg_rw_vec(
+    REG_ACC_T *reg_accs,                        /**< register access list */
+    unsigned int cnt,                           /**< access count */
+    uint8_t *res_list                           /**< result list (optional) */
+)
+{
+    return reg_ctx_rw_vec(&reg_ctx_dfl, reg_accs, cnt, res_list);
+}
+
+
+/*****************************************************************************/
+/** Announce register content of context
+ *
+ * Uses the announce hook of the context or reg_ann() if none is set.
+ */
+void reg_ctx_ann(
+    REGREG_CTX_T *ctx,                          /**< register context */
+    REG_ADDR_T addr,                            /**< register address */
+    void *data,                                 /**< data */
+    unsigned int len                            /**< data length */
+)
+{
+    if (ctx->ann) {
+        ctx->ann(ctx, addr, data, len);
+    } else {
+        reg_ann(addr, data, len);
+    }
+}
+
+
+#if PINKIE_CFG_REGREG_TYPES == 1
+/*****************************************************************************/
+/** Get value type at address
+ *
+ * @returns type of the value starting at the address or REGREG_TYPE_NONE if
+ *          the register is untyped or the address is inside a value
+ */
+uint8_t reg_ctx_type(
+    REGREG_CTX_T *ctx,                          /**< register context */
+    REG_ADDR_T addr                             /**< register address */
+)
+{
+    REG_ENTRY_T *reg;                           /* register */
+    REG_ENTRY_T buf;                            /* static entry buffer */
+
+    reg = reg_ctx_find(ctx, addr, &buf);
+    if ((!reg) || (!REGREG_TYPE_WIDTH(reg->type)) || (sizeof(uint64_t) < REGREG_TYPE_WIDTH(reg->type))) {
+        return REGREG_TYPE_NONE;
+    }
+
+    /* value must start at address and end inside the register */
+    if (((addr - reg->addr_beg) % REGREG_TYPE_WIDTH(reg->type)) ||
+        ((REG_ADDR_T) (reg->addr_end - addr) < (REG_ADDR_T) (REGREG_TYPE_WIDTH(reg->type) - 1))) {
+        return REGREG_TYPE_NONE;
+    }
+
+    return reg->type;
+}
+
+
+/*****************************************************************************/
+/** Get value type at address in default context
+ */
+uint8_t reg_type(
+    REG_ADDR_T addr                             /**< register address */
+)
+{
+    return reg_ctx_type(&reg_ctx_dfl, addr);
+}
+
+
+/*****************************************************************************/
+/** Decode typed value
+ *
+ * Converts the value from its register byte order and extends the sign of
+ * signed values to 64 bit.
+ */
+uint64_t reg_val_decode(
+    uint8_t type,                               /**< value type */
+    const uint8_t *data                         /**< value data */
+)
+{
+    unsigned int width = REGREG_TYPE_WIDTH(type); /* value width */
+    unsigned int cnt;                           /* counter */
+    uint64_t val = 0;                           /* value */
+
+    for (cnt = 0; cnt < width; cnt++) {
+        val <<= 8;
+        val |= data[(type & REGREG_TYPE_BE) ? cnt : (width - 1 - cnt)];
+    }
+
+    if ((type & REGREG_TYPE_SIGNED) && (width < sizeof(uint64_t)) && (val >> ((width * 8) - 1))) {
+        val |= UINT64_MAX << (width * 8);
+    }
+
+    return val;
+}
+#endif
+
+
+#if PINKIE_CFG_REGREG_CACHE == 1
+/*****************************************************************************/
+/** Register cache statistics
+ *
+ * Maps the cache hit and miss counters to the given base address.
+ */
+unsigned int reg_cache_init(
+    REG_ADDR_T rr_base                          /**< regreg base address */
+)
+{
+    cache_regreg_info.addr_beg = rr_base;
+    cache_regreg_info.addr_end = rr_base + sizeof(cache_stat) - 1;
+
+    return reg_add(&cache_regreg_info);
+}
+
+
+/*****************************************************************************/
+/** Invalidate register value cache
+ *
+ * Marks the cached value of the register containing the address as stale, so
+ * the next read calls the register callback again.
+ */
+void reg_cache_inval(
+    REG_ADDR_T addr                             /**< register address */
+)
+{
+    REG_ENTRY_T *reg;                           /* register */
+    REG_ENTRY_T buf;                            /* static entry buffer */
+
+    reg = reg_find(addr, &buf);
+    if ((reg) && (reg->cache)) {
+        reg->cache->flg_valid = 0;
+    }
+}
+#endif
+
+
+#if PINKIE_CFG_REGREG_STATS == 1
+/*****************************************************************************/
+/** Statistics register callback
+ *
+ * Writes select the register address, reads fetch the statistics of the
+ * entry containing the selected address. The statistics are read-only.
+ */
+static unsigned int reg_stat_cb(
+    REG_ENTRY_T *reg,                           /**< register */
+    REG_ACC_T *reg_acc                          /**< register access info */
+)
+{
+    REG_ENTRY_T *reg_sel;                       /* selected register */
+    REG_ENTRY_T buf;                            /* static entry buffer */
+
+    PINKIE_UNUSED(reg);
+
+    if (reg_acc->write_flg) {
+        if ((reg_acc->addr_ofs + reg_acc->data_len) > REGREG_STAT_REG_STAT) {
+            return 1;
+        }
+
+        return REGREG_RES_PROCEED;
+    }
+
+    reg_sel = reg_find(stat_reg.addr, &buf);
+    if ((reg_sel) && (reg_sel->stat)) {
+        stat_reg.stat = *reg_sel->stat;
+    } else {
+        memset(&stat_reg.stat, 0, sizeof(stat_reg.stat));
+    }
+
+    return REGREG_RES_PROCEED;
+}
+
+
+/*****************************************************************************/
+/** Register access statistics
+ *
+ * Maps the statistics register block to the given base address.
+ */
+unsigned int reg_stat_init(
+    REG_ADDR_T rr_base                          /**< regreg base address */
+)
+{
+    stat_regreg_info.addr_beg = rr_base;
+    stat_regreg_info.addr_end = rr_base + sizeof(stat_reg) - 1;
+
+    return reg_add(&stat_regreg_info);
+}
+#endif
+
+
+#if PINKIE_CFG_REGREG_PEND_CNT > 0
+/*****************************************************************************/
+/** Pending write status registers
+ *
+ * Maps the status of the last completed pending write to the given base
+ * address.
+ */
+unsigned int reg_pend_init(
+    REG_ADDR_T rr_base                          /**< regreg base address */
+)
+{
+    pend_regreg_info.addr_beg = rr_base;
+    pend_regreg_info.addr_end = rr_base + sizeof(pend_stat) - 1;
+
+    return reg_add(&pend_regreg_info);
+}
+
+
+/*****************************************************************************/
+/** Pending Write Processor
+ *
+ * Replays the pending writes in order. Processing stops at the first write
+ * that is still busy. Each completed write is announced by its address and
+ * result on the pending status registers.
+ */
+void reg_pend_process(
+    void
+)
+{
+    unsigned int res;                           /* result */
+    REG_PEND_T *pend;                           /* pending write */
+    REG_ENTRY_T *reg;                           /* register */
+    REG_ENTRY_T buf;                            /* static entry buffer */
+    REG_ACC_T reg_acc;                          /* register access */
+
+    while (pends_cnt) {
+        pend = &pends[pends_rd];
+
+        reg_acc.addr = pend->addr + pend->ofs;
+        reg_acc.write_flg = 1;
+        reg_acc.data.read_from = &pend->data[pend->ofs];
+        reg_acc.data_len = pend->len - pend->ofs;
+
+        reg = reg_ctx_find(pend->ctx, reg_acc.addr, &buf);
+        if (!reg) {
+            res = 1;
+        } else {
+#if PINKIE_CFG_REGREG_CACHE == 1
+            if (reg->cache) {
+                reg->cache->flg_valid = 0;
+            }
+#endif
+
+            res = reg_rw_cb(reg, &reg_acc);
+            if (REGREG_RES_BUSY == res) {
+                return;
+            }
+
+            /* a callback that handles no data would never complete */
+            if ((!res) && (!reg_acc.data_len)) {
+                res = 1;
+            }
+
+            /* continue behind the data handled by the callback */
+            if (!res) {
+                pend->ofs += reg_acc.data_len;
+                if (pend->ofs < pend->len) {
+                    continue;
+                }
+            }
+        }
+
+        /* announce completion, the status registers exist in the default context */
+        pend_stat.addr = pend->addr;
+        pend_stat.res = (uint8_t) res;
+        reg_ctx_ann(&reg_ctx_dfl, pend_regreg_info.addr_beg + REGREG_PEND_REG_ADDR, &pend_stat, sizeof(pend_stat.addr) + sizeof(pend_stat.res));
+
+        pends_rd = (pends_rd + 1) % PINKIE_CFG_REGREG_PEND_CNT;
+        pends_cnt--;
+    }
 }
+#endif
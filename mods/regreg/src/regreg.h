@@ -9,6 +9,91 @@
 #define REGREG_H
 
 #include <inttypes.h>
+#include <pinkie.h>
+
+
+/*****************************************************************************/
+/* Configuration */
+/*****************************************************************************/
+#ifndef PINKIE_CFG_REGREG_ENTRIES
+#  define PINKIE_CFG_REGREG_ENTRIES     8       /**< max register entries */
+#endif
+
+#ifndef PINKIE_CFG_REGREG_CACHE
+#  define PINKIE_CFG_REGREG_CACHE       0       /**< register value cache */
+#endif
+
+#ifndef PINKIE_CFG_REGREG_PEND_CNT
+#  define PINKIE_CFG_REGREG_PEND_CNT    0       /**< pending write queue size (0 = disabled) */
+#endif
+
+#ifndef PINKIE_CFG_REGREG_PEND_LEN
+#  define PINKIE_CFG_REGREG_PEND_LEN    4       /**< max data length of a pending write */
+#endif
+
+#ifndef PINKIE_CFG_REGREG_CONCURRENT
+#  define PINKIE_CFG_REGREG_CONCURRENT  0       /**< concurrent access from threads (Linux) */
+#endif
+
+#ifndef PINKIE_CFG_REGREG_LOCKS
+#  define PINKIE_CFG_REGREG_LOCKS       64      /**< striped register entry locks */
+#endif
+
+#ifndef PINKIE_CFG_REGREG_READERS
+#  define PINKIE_CFG_REGREG_READERS     64      /**< reader threads with lock-free lookup */
+#endif
+
+#ifndef PINKIE_CFG_REGREG_VEC_CNT
+#  define PINKIE_CFG_REGREG_VEC_CNT     8       /**< vectored accesses grouped per chunk */
+#endif
+
+#ifndef PINKIE_CFG_REGREG_VEC_BUF
+#  define PINKIE_CFG_REGREG_VEC_BUF     32      /**< vectored access group buffer */
+#endif
+
+#ifndef PINKIE_CFG_REGREG_TXN_LEN
+#  define PINKIE_CFG_REGREG_TXN_LEN     0       /**< transaction log bytes (0 = disabled) */
+#endif
+
+#ifndef PINKIE_CFG_REGREG_TYPES
+#  define PINKIE_CFG_REGREG_TYPES       0       /**< register type metadata */
+#endif
+
+#ifndef PINKIE_CFG_REGREG_STATS
+#  define PINKIE_CFG_REGREG_STATS       0       /**< per-entry access statistics */
+#endif
+
+#ifndef PINKIE_CFG_REGREG_STATS_TIME
+#  ifdef PINKIE_ARCH_TIME_US
+#    define PINKIE_CFG_REGREG_STATS_TIME() ((uint32_t) PINKIE_ARCH_TIME_US()) /**< callback time source in us */
+#  else
+#    define PINKIE_CFG_REGREG_STATS_TIME() ((uint32_t) pinkie_timer_get()) /**< callback time source in ms */
+#  endif
+#endif
+
+#ifndef PINKIE_CFG_REGREG_NVS
+#  define PINKIE_CFG_REGREG_NVS         0       /**< persistent register entries */
+#endif
+
+#ifndef PINKIE_CFG_REGREG_ADDR32
+#  define PINKIE_CFG_REGREG_ADDR32      0       /**< 32-bit register addresses */
+#endif
+
+#ifndef PINKIE_CFG_REGREG_PAGES
+#  define PINKIE_CFG_REGREG_PAGES       4       /**< 32-bit mode: page table pages per context */
+#endif
+
+#if (PINKIE_CFG_REGREG_ADDR32 == 1) && ((PINKIE_CFG_REGREG_PAGES < 1) || (PINKIE_CFG_REGREG_PAGES > 255))
+#  error "RegReg page count must be in the range 1..255"
+#endif
+
+#if (PINKIE_CFG_REGREG_CONCURRENT == 1) && (PINKIE_CFG_REGREG_PEND_CNT > 0)
+#  error "RegReg pending writes aren't supported in concurrent mode"
+#endif
+
+#if (PINKIE_CFG_REGREG_CONCURRENT == 1) && (PINKIE_CFG_REGREG_TXN_LEN > 0)
+#  error "RegReg transactions aren't supported in concurrent mode"
+#endif
 
 
 /*****************************************************************************/
@@ -16,6 +101,165 @@
 /*****************************************************************************/
 #define REGREG_RES_PROCEED              2       /**< proceed with register access */
 #define REGREG_RES_BUSY                 3       /**< access currently not possible */
+#define REGREG_RES_OVERLAP              4       /**< register range overlaps */
+#define REGREG_RES_FULL                 5       /**< register index full */
+#define REGREG_RES_PENDING              6       /**< write queued for later completion */
+
+#define REGREG_SECTION                  "regreg_tbl" /**< static register section */
+
+#if PINKIE_CFG_REGREG_ADDR32 == 1
+#  define REGREG_ADDR_MAX               UINT32_MAX /**< max register address */
+#  define PRIuREG                       PRIu32  /**< register address format */
+#else
+#  define REGREG_ADDR_MAX               UINT16_MAX /**< max register address */
+#  define PRIuREG                       PRIu16  /**< register address format */
+#endif
+
+#define REGREG_TYPE_NONE                0x00    /**< untyped bytes */
+#define REGREG_TYPE_WIDTH_MASK          0x0f    /**< value width in bytes */
+#define REGREG_TYPE_SIGNED              0x10    /**< signed value */
+#define REGREG_TYPE_BE                  0x20    /**< big endian byte order (default: little) */
+
+#define REGREG_TYPE_U8                  1       /**< 8-bit unsigned */
+#define REGREG_TYPE_I8                  (1 | REGREG_TYPE_SIGNED) /**< 8-bit signed */
+#define REGREG_TYPE_U16                 2       /**< 16-bit unsigned */
+#define REGREG_TYPE_I16                 (2 | REGREG_TYPE_SIGNED) /**< 16-bit signed */
+#define REGREG_TYPE_U32                 4       /**< 32-bit unsigned */
+#define REGREG_TYPE_I32                 (4 | REGREG_TYPE_SIGNED) /**< 32-bit signed */
+#define REGREG_TYPE_U64                 8       /**< 64-bit unsigned */
+#define REGREG_TYPE_I64                 (8 | REGREG_TYPE_SIGNED) /**< 64-bit signed */
+
+#define REGREG_TYPE_WIDTH(type)         ((type) & REGREG_TYPE_WIDTH_MASK)
+
+#define REGREG_FLG_NVS                  0x01    /**< entry data is persisted in NVS */
+
+#define REGREG_PT_SHIFT_DIR             24      /**< page table: directory index shift */
+#define REGREG_PT_SHIFT_WIN             16      /**< page table: window index shift */
+#define REGREG_PT_SLOTS                 256     /**< page table: slots per level */
+
+#define REGREG_CACHE_REG_CNT_HIT        offsetof(REGREG_CACHE_STAT_T, cnt_hit)
+#define REGREG_CACHE_REG_CNT_MISS       offsetof(REGREG_CACHE_STAT_T, cnt_miss)
+
+#define REGREG_PEND_REG_ADDR            offsetof(REGREG_PEND_STAT_T, addr)
+#define REGREG_PEND_REG_RES             offsetof(REGREG_PEND_STAT_T, res)
+#define REGREG_PEND_REG_CNT_FULL        offsetof(REGREG_PEND_STAT_T, cnt_full)
+
+#define REGREG_STAT_REG_ADDR            offsetof(REGREG_STAT_REG_T, addr)
+#define REGREG_STAT_REG_STAT            offsetof(REGREG_STAT_REG_T, stat)
+
+
+/*****************************************************************************/
+/* Macros */
+/*****************************************************************************/
+/**< optional register entry fields */
+#if PINKIE_CFG_REGREG_CACHE == 1
+#  define REGREG_ENTRY_OPT_CACHE(cache) , cache
+#else
+#  define REGREG_ENTRY_OPT_CACHE(cache)
+#endif
+
+#if PINKIE_CFG_REGREG_TYPES == 1
+#  define REGREG_ENTRY_OPT_TYPE(type)   , type
+#else
+#  define REGREG_ENTRY_OPT_TYPE(type)
+#endif
+
+#if PINKIE_CFG_REGREG_STATS == 1
+#  define REGREG_ENTRY_OPT_STAT(stat)   , stat
+#  define REGREG_STAT_DEF(name)         static REGREG_STAT_T name##_stat;
+#  define REGREG_STAT_REF(name)         &name##_stat
+#else
+#  define REGREG_ENTRY_OPT_STAT(stat)
+#  define REGREG_STAT_DEF(name)
+#  define REGREG_STAT_REF(name)         NULL
+#endif
+
+#if PINKIE_CFG_REGREG_NVS == 1
+#  define REGREG_ENTRY_OPT_FLG(flg)     , flg
+#else
+#  define REGREG_ENTRY_OPT_FLG(flg)
+#endif
+
+/**< register entry initializer
+ *
+ * Optional fields like the value cache, the type, the statistics or the flags
+ * only exist if they are enabled, so entries should be initialized by these
+ * macros. The type describes each value in the register range, which starts
+ * at addr_beg and repeats every type width.
+ */
+#define REGREG_ENTRY_INIT_FLG(beg, end, cb, data, cache, type, stat, flg) \
+    { beg, end, cb, data REGREG_ENTRY_OPT_CACHE(cache) REGREG_ENTRY_OPT_TYPE(type) REGREG_ENTRY_OPT_STAT(stat) REGREG_ENTRY_OPT_FLG(flg) }
+
+#define REGREG_ENTRY_INIT_STAT(beg, end, cb, data, cache, type, stat) \
+    REGREG_ENTRY_INIT_FLG(beg, end, cb, data, cache, type, stat, 0)
+
+#define REGREG_ENTRY_INIT_TYPED(beg, end, cb, data, cache, type) \
+    REGREG_ENTRY_INIT_STAT(beg, end, cb, data, cache, type, NULL)
+
+#define REGREG_ENTRY_INIT(beg, end, cb, data, cache) \
+    REGREG_ENTRY_INIT_TYPED(beg, end, cb, data, cache, REGREG_TYPE_NONE)
+
+/**< static register entry
+ *
+ * Static entries are collected by the linker in the REGREG_SECTION and are
+ * available without calling reg_add(). After linking, regreg_tbl.py sorts
+ * the section by address and fails the build on overlapping ranges. The
+ * entry is constant and kept in flash on AVR by regreg_tbl_avr.x, only its
+ * statistics are placed in RAM.
+ */
+#define REGREG_ENTRY(name, beg, end, cb, data) \
+    REGREG_ENTRY_TYPED(name, beg, end, cb, data, REGREG_TYPE_NONE)
+
+/**< static register entry with value type */
+#define REGREG_ENTRY_TYPED(name, beg, end, cb, data, type) \
+    REGREG_ENTRY_DEF(name, beg, end, cb, data, NULL, type, 0)
+
+/**< static register entry with all options */
+#define REGREG_ENTRY_DEF(name, beg, end, cb, data, cache_ptr, type, flg) \
+    REGREG_STAT_DEF(name) \
+    PINKIE_CC_ASSERT((beg) <= (end), "invalid register range: " #name); \
+    static const REG_ENTRY_T name \
+    __attribute__((used, section(REGREG_SECTION), aligned(__alignof__(REG_ENTRY_T)))) = \
+        REGREG_ENTRY_INIT_FLG(beg, end, cb, data, cache_ptr, type, REGREG_STAT_REF(name), flg)
+
+#if PINKIE_CFG_REGREG_NVS == 1
+
+/**< static persistent register entry
+ *
+ * Written data is marked dirty and written back to NVS by reg_nvs_process()
+ * once no further change happened for the configured quiet period. The data
+ * must be part of the NVS image given to reg_nvs_init().
+ */
+#define REGREG_ENTRY_NVS(name, beg, end, cb, data) \
+    REGREG_ENTRY_DEF(name, beg, end, cb, data, NULL, REGREG_TYPE_NONE, REGREG_FLG_NVS)
+
+#endif /* PINKIE_CFG_REGREG_NVS */
+
+#if PINKIE_CFG_REGREG_CACHE == 1
+
+/**< static register entry with value cache
+ *
+ * Reads are served from the cache until its TTL expires. The cache must be
+ * defined by REGREG_CACHE with the size of the register range.
+ */
+#define REGREG_ENTRY_CACHED(name, beg, end, cb, data, cache) \
+    REGREG_ENTRY_CACHED_TYPED(name, beg, end, cb, data, cache, REGREG_TYPE_NONE)
+
+/**< static register entry with value cache and value type */
+#define REGREG_ENTRY_CACHED_TYPED(name, beg, end, cb, data, cache, type) \
+    REGREG_ENTRY_DEF(name, beg, end, cb, data, &cache, type, 0)
+
+/**< register value cache */
+#define REGREG_CACHE(name, ttl, len) \
+    static uint8_t name##_data[len]; \
+    static REGREG_CACHE_T name = { \
+        ttl, \
+        0, \
+        0, \
+        name##_data, \
+    }
+
+#endif /* PINKIE_CFG_REGREG_CACHE */
 
 
 /*****************************************************************************/
@@ -23,6 +267,16 @@
 /*****************************************************************************/
 struct REG_ACC_T;
 struct REG_ENTRY_T;
+struct REGREG_CTX_T;
+struct REGREG_SNAP_T;
+
+
+/**< register address */
+#if PINKIE_CFG_REGREG_ADDR32 == 1
+typedef uint32_t REG_ADDR_T;
+#else
+typedef uint16_t REG_ADDR_T;
+#endif
 
 
 /**< register callback function */
@@ -34,8 +288,8 @@ typedef unsigned int (* REG_CB_T)( \
 
 /**< register access info */
 typedef struct REG_ACC_T {
-    uint16_t addr;                              /**< address */
-    uint16_t addr_ofs;                          /**< address offset */
+    REG_ADDR_T addr;                            /**< address */
+    REG_ADDR_T addr_ofs;                        /**< address offset */
     uint8_t write_flg;                          /**< write flag */
     union {
         const uint8_t *read_from;               /**< data pointer */
@@ -45,31 +299,274 @@ typedef struct REG_ACC_T {
 } REG_ACC_T;
 
 
+/**< register value cache */
+typedef struct {
+    uint16_t ttl_ms;                            /**< time to live in ms */
+    uint8_t flg_valid;                          /**< cached data valid flag */
+    uint32_t ts;                                /**< fill timestamp in ms */
+    uint8_t *data;                              /**< cached data */
+} REGREG_CACHE_T;
+
+
+/**< register value cache statistics
+ *
+ * Not packed, the counters are updated atomically in concurrent mode. The
+ * layout has no padding anyway.
+ */
+typedef struct {
+    uint16_t cnt_hit;                           /**< [rr:0-1] cache hits */
+    uint16_t cnt_miss;                          /**< [rr:2-3] cache misses */
+} REGREG_CACHE_STAT_T;
+
+
+/**< pending write status
+ *
+ * Offsets are given for 16 bit addresses / PINKIE_CFG_REGREG_ADDR32.
+ */
+typedef struct {
+    REG_ADDR_T addr;                            /**< [rr:0-1 / 0-3] last completed write address */
+    uint8_t res;                                /**< [rr:2 / 4] last completed write result */
+    uint8_t cnt_full;                           /**< [rr:3 / 5] writes rejected by full queue */
+} __attribute__((packed)) REGREG_PEND_STAT_T;
+
+
+/**< register entry statistics
+ *
+ * Counters wrap around. Times are given in PINKIE_CFG_REGREG_STATS_TIME ticks,
+ * by default microseconds if the architecture provides them, else milliseconds.
+ * Like the cache statistics not packed for atomic updates.
+ */
+typedef struct {
+    uint16_t cnt_rd;                            /**< [rr:0-1] read accesses */
+    uint16_t cnt_wr;                            /**< [rr:2-3] write accesses */
+    uint16_t cnt_busy;                          /**< [rr:4-5] busy rejections */
+    uint16_t time_max;                          /**< [rr:6-7] max callback time */
+    uint32_t time_sum;                          /**< [rr:8-11] total callback time */
+} REGREG_STAT_T;
+
+
+/**< register statistics block
+ *
+ * Offsets are given for 16 bit addresses / PINKIE_CFG_REGREG_ADDR32.
+ */
+typedef struct {
+    REG_ADDR_T addr;                            /**< [rr:0-1 / 0-3] selected register address */
+    REGREG_STAT_T stat;                         /**< [rr:2-13 / 4-15] statistics of selected register */
+} __attribute__((packed)) REGREG_STAT_REG_T;
+
+
 /**< register entry */
 typedef struct REG_ENTRY_T {
-    struct REG_ENTRY_T *next;                   /**< next element */
-
-    uint16_t addr_beg;                          /**< start address */
-    uint16_t addr_end;                          /**< end address */
+    REG_ADDR_T addr_beg;                        /**< start address */
+    REG_ADDR_T addr_end;                        /**< end address */
 
     REG_CB_T cb;                                /**< callback function */
     void *data;                                 /**< specific data */
+
+#if PINKIE_CFG_REGREG_CACHE == 1
+    REGREG_CACHE_T *cache;                      /**< value cache (optional) */
+#endif
+
+#if PINKIE_CFG_REGREG_TYPES == 1
+    uint8_t type;                               /**< value type (REGREG_TYPE_*) */
+#endif
+
+#if PINKIE_CFG_REGREG_STATS == 1
+    REGREG_STAT_T *stat;                        /**< access statistics (optional) */
+#endif
+
+#if PINKIE_CFG_REGREG_NVS == 1
+    uint8_t flg;                                /**< entry flags (REGREG_FLG_*) */
+#endif
 } REG_ENTRY_T;
 
 
+/**< register context announce hook */
+typedef void (* REG_ANN_CB_T)( \
+    struct REGREG_CTX_T *ctx,                   /**< register context */
+    REG_ADDR_T addr,                            /**< register address */
+    void *data,                                 /**< data */
+    unsigned int len                            /**< data length */
+);
+
+
+#if PINKIE_CFG_REGREG_ADDR32 == 1
+/**< page table slot: index range of the registers in a 64k address window */
+typedef struct {
+    uint16_t pos;                               /**< first index position */
+    uint16_t cnt;                               /**< register count */
+} REGREG_PT_SLOT_T;
+
+
+/**< two-level page table
+ *
+ * The directory selects a page by the upper address byte, the page slot by
+ * the second address byte. Only directory entries with registers use a page.
+ */
+typedef struct {
+    uint8_t dir[REGREG_PT_SLOTS];               /**< page number + 1 (0 = unmapped) */
+    uint8_t pages_cnt;                          /**< used pages */
+    REGREG_PT_SLOT_T pages[PINKIE_CFG_REGREG_PAGES][REGREG_PT_SLOTS]; /**< pages */
+} REGREG_PT_T;
+#endif
+
+
+/**< register context
+ *
+ * A context is an independent register space. The global API works on a
+ * default context that also contains the static register table.
+ */
+typedef struct REGREG_CTX_T {
+    REG_ENTRY_T **regs;                         /**< sorted register index */
+    unsigned int regs_max;                      /**< register index size */
+    unsigned int regs_cnt;                      /**< register count */
+    uint8_t flg_tbl;                            /**< include static register table */
+
+    REG_ANN_CB_T ann;                           /**< announce hook (NULL: reg_ann) */
+    void *priv;                                 /**< user data */
+
+#if PINKIE_CFG_REGREG_ADDR32 == 1
+    REGREG_PT_T pt;                             /**< page table */
+#endif
+
+#if PINKIE_CFG_REGREG_CONCURRENT == 1
+    struct REGREG_SNAP_T *snap;                 /**< published index snapshot */
+#endif
+} REGREG_CTX_T;
+
+
 /*****************************************************************************/
 /* Prototypes */
 /*****************************************************************************/
-void reg_add(
+void reg_ctx_init(
+    REGREG_CTX_T *ctx,                          /**< register context */
+    REG_ENTRY_T **regs,                         /**< register index storage */
+    unsigned int regs_max,                      /**< register index size */
+    REG_ANN_CB_T ann,                           /**< announce hook (optional) */
+    void *priv                                  /**< user data */
+);
+
+REGREG_CTX_T * reg_ctx_dfl_get(
+    void
+);
+
+unsigned int reg_ctx_add(
+    REGREG_CTX_T *ctx,                          /**< register context */
+    REG_ENTRY_T *reg                            /**< register entry pointer */
+);
+
+REG_ENTRY_T * reg_ctx_entry_get(
+    REGREG_CTX_T *ctx,                          /**< register context */
+    unsigned int pos,                           /**< entry position */
+    REG_ENTRY_T *buf                            /**< static entry buffer */
+);
+
+REG_ENTRY_T * reg_ctx_find(
+    REGREG_CTX_T *ctx,                          /**< register context */
+    REG_ADDR_T addr,                            /**< register address */
+    REG_ENTRY_T *buf                            /**< static entry buffer */
+);
+
+unsigned int reg_ctx_rw(
+    REGREG_CTX_T *ctx,                          /**< register context */
+    REG_ACC_T *reg_acc                          /**< register access info */
+);
+
+unsigned int reg_ctx_rw_vec(
+    REGREG_CTX_T *ctx,                          /**< register context */
+    REG_ACC_T *reg_accs,                        /**< register access list */
+    unsigned int cnt,                           /**< access count */
+    uint8_t *res_list                           /**< result list (optional) */
+);
+
+void reg_ctx_ann(
+    REGREG_CTX_T *ctx,                          /**< register context */
+    REG_ADDR_T addr,                            /**< register address */
+    void *data,                                 /**< data */
+    unsigned int len                            /**< data length */
+);
+
+unsigned int reg_init(
+    void
+);
+
+unsigned int reg_add(
     REG_ENTRY_T *reg                            /**< register entry pointer */
 );
 
+REG_ENTRY_T * reg_find(
+    REG_ADDR_T addr,                            /**< register address */
+    REG_ENTRY_T *buf                            /**< static entry buffer */
+);
+
 unsigned int reg_rw(
     REG_ACC_T *reg_acc                          /**< register access info */
 );
 
+unsigned int reg_rw_vec(
+    REG_ACC_T *reg_accs,                        /**< register access list */
+    unsigned int cnt,                           /**< access count */
+    uint8_t *res_list                           /**< result list (optional) */
+);
+
+#if PINKIE_CFG_REGREG_TYPES == 1
+uint8_t reg_ctx_type(
+    REGREG_CTX_T *ctx,                          /**< register context */
+    REG_ADDR_T addr                             /**< register address */
+);
+
+uint8_t reg_type(
+    REG_ADDR_T addr                             /**< register address */
+);
+
+uint64_t reg_val_decode(
+    uint8_t type,                               /**< value type */
+    const uint8_t *data                         /**< value data */
+);
+#endif
+
+#if PINKIE_CFG_REGREG_CACHE == 1
+unsigned int reg_cache_init(
+    REG_ADDR_T rr_base                          /**< regreg base address */
+);
+
+void reg_cache_inval(
+    REG_ADDR_T addr                             /**< register address */
+);
+#endif
+
+#if PINKIE_CFG_REGREG_STATS == 1
+unsigned int reg_stat_init(
+    REG_ADDR_T rr_base                          /**< regreg base address */
+);
+#endif
+
+#if PINKIE_CFG_REGREG_PEND_CNT > 0
+unsigned int reg_pend_init(
+    REG_ADDR_T rr_base                          /**< regreg base address */
+);
+
+void reg_pend_process(
+    void
+);
+#endif
+
+#if PINKIE_CFG_REGREG_TXN_LEN > 0
+unsigned int reg_txn_stage(
+    REGREG_CTX_T *ctx,                          /**< register context */
+    REG_ACC_T *reg_acc                          /**< register access info */
+);
+#endif
+
+#if PINKIE_CFG_REGREG_NVS == 1
+void reg_nvs_mark(
+    const void *data,                           /**< changed data */
+    unsigned int len                            /**< changed data length */
+);
+#endif
+
 void reg_ann(
-    uint16_t addr,                              /**< register address */
+    REG_ADDR_T addr,                            /**< register address */
     void *data,                                 /**< data */
     unsigned int len                            /**< data length */
 );
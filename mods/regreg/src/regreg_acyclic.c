@@ -10,6 +10,37 @@
 #include <regreg_acyclic.h>
 
 
+/*****************************************************************************/
+/* Configuration */
+/*****************************************************************************/
+#ifndef PINKIE_CFG_REGREG_ACYCLIC_VEC_CNT
+#  define PINKIE_CFG_REGREG_ACYCLIC_VEC_CNT 8   /**< max accesses per readv */
+#endif
+
+#ifndef PINKIE_CFG_REGREG_ACYCLIC_VEC_LEN
+#  define PINKIE_CFG_REGREG_ACYCLIC_VEC_LEN 32  /**< max bytes per readv */
+#endif
+
+#if (PINKIE_CFG_REGREG_ADDR32 == 1) && (PINKIE_CFG_SSCANF_MAX_INT < 4)
+#  error "32-bit RegReg addresses require PINKIE_CFG_SSCANF_MAX_INT >= 4"
+#endif
+
+
+/*****************************************************************************/
+/* Local defines */
+/*****************************************************************************/
+/**< scan whole argument as unsigned integer */
+#define CMD_REG_SCAN(arg, width, val) \
+    (((arg)->name + (arg)->len) == pinkie_scan_int((arg)->name, (arg)->name + (arg)->len, width, PINKIE_SCAN_UNSIGNED, val))
+
+/**< precompiled read output "addr: 0xval (u: val, i: val)\n" */
+#define CMD_REG_FMT_READ(utype, itype, digits) { \
+    PINKIE_FMT_U(REG_ADDR_T), PINKIE_FMT_TEXT(": 0x"), PINKIE_FMT_X0(utype, digits), \
+    PINKIE_FMT_TEXT(" (u: "), PINKIE_FMT_U(utype), PINKIE_FMT_TEXT(", i: "), PINKIE_FMT_I(itype), \
+    PINKIE_FMT_TEXT(")\n"), PINKIE_FMT_END \
+}
+
+
 /*****************************************************************************/
 /* Local datatypes */
 /*****************************************************************************/
@@ -40,11 +71,47 @@ static uint8_t cmd_func_reg_write(
     struct ACYCLIC_T *a
 );
 
+static uint8_t cmd_func_reg_readv(
+    struct ACYCLIC_T *a
+);
+
+#if PINKIE_CFG_REGREG_STATS == 1
+static uint8_t cmd_func_reg_stats(
+    struct ACYCLIC_T *a
+);
+#endif
+
+#if PINKIE_CFG_REGREG_TYPES == 1
+static unsigned int cmd_reg_type_width(
+    uint8_t type                                /**< value type */
+);
+#endif
+
+
+/*****************************************************************************/
+/* Local variables */
+/*****************************************************************************/
+static const PINKIE_FMT_OP_T cmd_reg_fmt_read8[] = CMD_REG_FMT_READ(uint8_t, int8_t, 2); /**< 8-bit read output */
+static const PINKIE_FMT_OP_T cmd_reg_fmt_read16[] = CMD_REG_FMT_READ(uint16_t, int16_t, 4); /**< 16-bit read output */
+#if PINKIE_CFG_PRINTF_MAX_INT >= 4
+static const PINKIE_FMT_OP_T cmd_reg_fmt_read32[] = CMD_REG_FMT_READ(uint32_t, int32_t, 8); /**< 32-bit read output */
+#endif
+#if PINKIE_CFG_PRINTF_MAX_INT >= 8
+static const PINKIE_FMT_OP_T cmd_reg_fmt_read64[] = CMD_REG_FMT_READ(uint64_t, int64_t, 16); /**< 64-bit read output */
+#endif
+
 
 /*****************************************************************************/
 /* Commands */
 /*****************************************************************************/
-ACYCLIC_CMD(reg_write, "write", NULL, NULL, cmd_func_reg_write);
+#if PINKIE_CFG_REGREG_STATS == 1
+ACYCLIC_CMD(reg_stats, "stats", NULL, NULL, cmd_func_reg_stats);
+#  define CMD_REG_STATS                 &cmd_reg_stats
+#else
+#  define CMD_REG_STATS                 NULL
+#endif
+ACYCLIC_CMD(reg_readv, "readv", CMD_REG_STATS, NULL, cmd_func_reg_readv);
+ACYCLIC_CMD(reg_write, "write", &cmd_reg_readv, NULL, cmd_func_reg_write);
 ACYCLIC_CMD(reg_read64, "read64", &cmd_reg_write, NULL, cmd_func_reg_read);
 ACYCLIC_CMD(reg_read32, "read32", &cmd_reg_read64, NULL, cmd_func_reg_read);
 ACYCLIC_CMD(reg_read16, "read16", &cmd_reg_read32, NULL, cmd_func_reg_read);
@@ -75,6 +142,11 @@ static uint8_t cmd_func_reg_read(
     uint16_t range;                             /* read range */
     uint8_t flg_string = 0;                     /* string flag */
     REG_ACC_T reg_acc;                          /* register access */
+#if PINKIE_CFG_REGREG_TYPES == 1
+    uint8_t flg_typed = 0;                      /* typed value flag */
+    uint8_t type = REGREG_TYPE_NONE;            /* value type */
+    uint64_t val;                               /* decoded value */
+#endif
 
     /* read size */
     if (cmd_name_reg_read16 == a->args[1].name) {
@@ -95,44 +167,83 @@ static uint8_t cmd_func_reg_read(
     }
 
     /* initialize register access */
-    pinkie_s2i(a->args[2].name, sizeof(uint16_t), UINT16_MAX, &reg_acc.addr, 0, 0);
+    if (!CMD_REG_SCAN(&a->args[2], sizeof(REG_ADDR_T), &reg_acc.addr)) {
+        return 1;
+    }
     reg_acc.write_flg = 0;
     reg_acc.data.write_to = (uint8_t *) &data;
-    range = (3 < a->arg_cnt) ? (uint8_t) str_to_u16(a->args[3].name, a->args[3].len) : 1;
 
-    /* read string flag if available */
+    range = 1;
+    if ((3 < a->arg_cnt) && (!CMD_REG_SCAN(&a->args[3], sizeof(range), &range))) {
+        return 1;
+    }
+
+    /* read string or typed value flag if available */
     if (4 < a->arg_cnt) {
         flg_string = ('s' == a->args[4].name[0]);
+#if PINKIE_CFG_REGREG_TYPES == 1
+        flg_typed = ('t' == a->args[4].name[0]);
+#endif
     }
 
     for (; range--; reg_acc.addr++) {
+
+#if PINKIE_CFG_REGREG_TYPES == 1
+        /* typed reads of typed registers read the whole value, plain reads
+         * stay byte-wise so hosts can poll each byte of a value */
+        if ((cmd_name_reg_read == a->args[1].name) && (flg_typed)) {
+            type = reg_type(reg_acc.addr);
+            reg_acc.data_len = cmd_reg_type_width(type);
+        }
+#endif
+
         res = reg_rw(&reg_acc);
         if (res) {
-            ACYCLIC_PLAT_PRINTF("%u: denied\n", reg_acc.addr);
+            ACYCLIC_PLAT_PRINTF("%" PRIuREG ": denied\n", reg_acc.addr);
             continue;
         }
 
+#if PINKIE_CFG_REGREG_TYPES == 1
+        /* convert typed value from register byte order */
+        if (1 < cmd_reg_type_width(type)) {
+            val = reg_val_decode(type, (const uint8_t *) &data);
+            if (sizeof(uint16_t) == reg_acc.data_len) {
+                data.val16 = (uint16_t) val;
+            }
+#if PINKIE_CFG_PRINTF_MAX_INT >= 4
+            else if (sizeof(uint32_t) == reg_acc.data_len) {
+                data.val32 = (uint32_t) val;
+            }
+#endif
+#if PINKIE_CFG_PRINTF_MAX_INT >= 8
+            else if (sizeof(uint64_t) == reg_acc.data_len) {
+                data.val64 = val;
+            }
+#endif
+        }
+#endif
+
         if (flg_string) {
             ACYCLIC_PLAT_PUTC(*((char *) &data));
         } else {
             if (sizeof(uint16_t) == reg_acc.data_len) {
-                ACYCLIC_PLAT_PRINTF("%u: 0x%04" PRIx16 " (u: %" PRIu16 ", i: %" PRIi16 ")\n", reg_acc.addr, data.val16, data.val16, data.vali16);
+                pinkie_printf_fmt(cmd_reg_fmt_read16, reg_acc.addr, data.val16, data.val16, data.vali16);
                 reg_acc.addr++;
             }
 #if PINKIE_CFG_PRINTF_MAX_INT >= 4
             else if (sizeof(uint32_t) == reg_acc.data_len) {
-                ACYCLIC_PLAT_PRINTF("%u: 0x%08" PRIx32 " (u: %" PRIu32 ", i: %" PRIi32 ")\n", reg_acc.addr, data.val32, data.val32, data.vali32);
+                pinkie_printf_fmt(cmd_reg_fmt_read32, reg_acc.addr, data.val32, data.val32, data.vali32);
                 reg_acc.addr += 3;
             }
 #endif
 #if PINKIE_CFG_PRINTF_MAX_INT >= 8
             else if (sizeof(uint64_t) == reg_acc.data_len) {
-                ACYCLIC_PLAT_PRINTF("%u: 0x%016" PRIx64 " (u: %" PRIu64 ", i: %" PRIi64 ")\n", reg_acc.addr, data.val64, data.val64, data.vali64);
+                pinkie_printf_fmt(cmd_reg_fmt_read64, reg_acc.addr, data.val64, data.val64, data.vali64);
                 reg_acc.addr += 7;
             }
 #endif
             else {
-                ACYCLIC_PLAT_PRINTF("%u: 0x%02x (u: %u, i: %i)\n", reg_acc.addr, data.val8, data.val8, data.vali8);
+                pinkie_printf_fmt(cmd_reg_fmt_read8, reg_acc.addr, data.val8, data.val8, data.vali8);
             }
         }
     }
@@ -146,78 +257,196 @@ static uint8_t cmd_func_reg_read(
 
 
 /*****************************************************************************/
-/** CLI Write Single Register
+/** CLI Vectored Register Read
+ *
+ * Reads a list of registers in one batch and prints all values in one line.
+ * The list is given as "addr[:len],addr[:len],..." and can be split over
+ * multiple arguments, e.g. "reg readv 4100:3,4104:2 2000:2".
  */
-static uint8_t cmd_func_reg_write(
+static uint8_t cmd_func_reg_readv(
     struct ACYCLIC_T *a
 )
 {
-    uint8_t data;                               /* register data */
+    REG_ACC_T reg_accs[PINKIE_CFG_REGREG_ACYCLIC_VEC_CNT]; /* register accesses */
+    uint8_t res_list[PINKIE_CFG_REGREG_ACYCLIC_VEC_CNT]; /* access results */
+    uint8_t data[PINKIE_CFG_REGREG_ACYCLIC_VEC_LEN]; /* register data */
+    unsigned int cnt = 0;                       /* access count */
+    unsigned int len = 0;                       /* data length */
     unsigned int cnt_arg;                       /* argument counter */
-    REG_ACC_T reg_acc;                          /* register access */
+    unsigned int cnt_acc;                       /* access counter */
+    unsigned int cnt_byte;                      /* byte counter */
+    const char *str;                            /* argument string */
+    const char *str_end;                        /* argument end */
+    REG_ADDR_T addr;                            /* register address */
+    uint16_t acc_len;                           /* access length */
+
+    /* parse access list */
+    for (cnt_arg = 2; cnt_arg < a->arg_cnt; cnt_arg++) {
+        str = a->args[cnt_arg].name;
+        str_end = str + a->args[cnt_arg].len;
+
+        while (str < str_end) {
+            str = pinkie_scan_int(str, str_end, sizeof(REG_ADDR_T), PINKIE_SCAN_UNSIGNED, &addr);
+            if (!str) {
+                return 1;
+            }
 
-    /* initialize register access */
-    reg_acc.addr = str_to_u16(a->args[2].name, a->args[2].len);
-    reg_acc.write_flg = 1;
+            acc_len = 1;
+            if ((str < str_end) && (':' == *str)) {
+                str = pinkie_scan_int(str + 1, str_end, sizeof(uint16_t), PINKIE_SCAN_UNSIGNED, &acc_len);
+                if (!str) {
+                    return 1;
+                }
+            }
 
-    /* iterate through arguments */
-    for (cnt_arg = 3; cnt_arg < a->arg_cnt; cnt_arg++) {
+            if ((!acc_len) || (PINKIE_CFG_REGREG_ACYCLIC_VEC_CNT <= cnt) || (PINKIE_CFG_REGREG_ACYCLIC_VEC_LEN < (len + acc_len))) {
+                return 1;
+            }
+
+            reg_accs[cnt].addr = addr;
+            reg_accs[cnt].write_flg = 0;
+            reg_accs[cnt].data.write_to = &data[len];
+            reg_accs[cnt].data_len = acc_len;
+            len += acc_len;
+            cnt++;
 
-        /* check if data argument is a string */
-        if ('"' == a->args[cnt_arg].name[0]) {
-            reg_acc.data.read_from = (const uint8_t *) &a->args[cnt_arg].name[1];
-            reg_acc.data_len = 0;
-            for (a->args[cnt_arg].name++; ('"' != a->args[cnt_arg].name[0]) && (0 < a->args[cnt_arg].len); a->args[cnt_arg].name++, a->args[cnt_arg].len--, reg_acc.data_len++);
+            /* skip list separator */
+            if ((str < str_end) && (',' == *str)) {
+                str++;
+            }
+        }
+    }
 
-            /* only 1 string is supported, leave after processing it */
-            cnt_arg = a->arg_cnt;
+    /* access all registers in one batch */
+    reg_rw_vec(reg_accs, cnt, res_list);
 
-        } else {
+    /* print results in one line */
+    for (cnt_acc = 0; cnt_acc < cnt; cnt_acc++) {
+        ACYCLIC_PLAT_PRINTF("%s%" PRIuREG ":", (cnt_acc) ? ", " : "", reg_accs[cnt_acc].addr);
 
-            /* TODO: switch to sscanf - argument is a single byte */
-            data = (uint8_t) str_to_u16(a->args[cnt_arg].name, a->args[cnt_arg].len);
-            reg_acc.data.read_from = &data;
-            reg_acc.data_len = 1;
+        if (res_list[cnt_acc]) {
+            ACYCLIC_PLAT_PRINTF(" denied");
+            continue;
         }
 
-        if (reg_rw(&reg_acc)) {
-            ACYCLIC_PLAT_PRINTF("%u: write failed\n", reg_acc.addr);
-            break;
+        for (cnt_byte = 0; cnt_byte < reg_accs[cnt_acc].data_len; cnt_byte++) {
+            ACYCLIC_PLAT_PRINTF(" 0x%02x", reg_accs[cnt_acc].data.write_to[cnt_byte]);
         }
+    }
+    ACYCLIC_PLAT_PUTC('\n');
+
+    return 0;
+}
 
-        /* increment register address for single byte access */
-        reg_acc.addr++;
+
+#if PINKIE_CFG_REGREG_STATS == 1
+/*****************************************************************************/
+/** CLI Register Statistics
+ *
+ * Prints the access statistics of every register entry that was accessed.
+ */
+static uint8_t cmd_func_reg_stats(
+    struct ACYCLIC_T *a
+)
+{
+    unsigned int pos;                           /* entry position */
+    REG_ENTRY_T *reg;                           /* register */
+    REG_ENTRY_T buf;                            /* static entry buffer */
+
+    PINKIE_UNUSED(a);
+
+    for (pos = 0; NULL != (reg = reg_ctx_entry_get(reg_ctx_dfl_get(), pos, &buf)); pos++) {
+        if ((!reg->stat) || ((!reg->stat->cnt_rd) && (!reg->stat->cnt_wr))) {
+            continue;
+        }
+
+        ACYCLIC_PLAT_PRINTF("%" PRIuREG "-%" PRIuREG ": rd %u, wr %u, busy %u, max %u",
+                            reg->addr_beg, reg->addr_end,
+                            reg->stat->cnt_rd, reg->stat->cnt_wr,
+                            reg->stat->cnt_busy, reg->stat->time_max);
+#if PINKIE_CFG_PRINTF_MAX_INT >= 4
+        ACYCLIC_PLAT_PRINTF(", sum %" PRIu32, reg->stat->time_sum);
+#endif
+        ACYCLIC_PLAT_PUTC('\n');
     }
 
     return 0;
 }
+#endif
 
 
 /*****************************************************************************/
-/** String To Unsigned Int 16 Bit
+/** CLI Write Registers
+ *
+ * Each argument is a quoted string or a comma separated byte list, e.g.
+ * "reg write 1000 1,0x02,-1 4", and is written in one access to the
+ * following registers.
  */
-uint16_t str_to_u16(
-    const char *str,                            /**< string */
-    unsigned int len                            /**< length */
+static uint8_t cmd_func_reg_write(
+    struct ACYCLIC_T *a
 )
 {
-    uint16_t val = 0;                           /* value */
-    unsigned int mul = 1;                       /* multiplicator */
+    uint8_t data[ACYCLIC_CMDLINE_LEN];          /* register data */
+    unsigned int len;                           /* data length */
+    unsigned int cnt_arg;                       /* argument counter */
+    unsigned int res;                           /* result */
+    const char *str_end;                        /* argument end */
+    REG_ACC_T reg_acc;                          /* register access */
 
-    /* check if parameters are valid (max value 65536) */
-    if ((NULL == str) || (5 < len)) {
-        return 0;
+    /* initialize register access */
+    if (!CMD_REG_SCAN(&a->args[2], sizeof(REG_ADDR_T), &reg_acc.addr)) {
+        return 1;
     }
+    reg_acc.write_flg = 1;
+    reg_acc.data.read_from = data;
 
-    /* parse from string end */
-    for (; len--;) {
-        if (('0' <= str[len]) && ('9' >= str[len])) {
-            val += ((unsigned int) str[len] - '0') * mul;
-            mul *= 10;
-        } else {
-            return 0;
+    /* iterate through arguments */
+    for (cnt_arg = 3; cnt_arg < a->arg_cnt; cnt_arg++) {
+
+        len = sizeof(data);
+        str_end = a->args[cnt_arg].name + a->args[cnt_arg].len;
+        if (str_end != pinkie_scan_bytes(a->args[cnt_arg].name, str_end, data, &len)) {
+            return 1;
+        }
+        reg_acc.data_len = len;
+
+        res = reg_rw(&reg_acc);
+        if (REGREG_RES_PENDING == res) {
+            ACYCLIC_PLAT_PRINTF("%" PRIuREG ": write pending\n", reg_acc.addr);
+        } else if (res) {
+            ACYCLIC_PLAT_PRINTF("%" PRIuREG ": write failed\n", reg_acc.addr);
+            break;
         }
+
+        /* continue behind written registers */
+        reg_acc.addr += len;
     }
 
-    return val;
+    return 0;
 }
+
+
+#if PINKIE_CFG_REGREG_TYPES == 1
+/*****************************************************************************/
+/** Printable Width Of Value Type
+ *
+ * @returns value width or 1 if the type can't be printed as a whole
+ */
+static unsigned int cmd_reg_type_width(
+    uint8_t type                                /**< value type */
+)
+{
+    switch (REGREG_TYPE_WIDTH(type)) {
+        case sizeof(uint16_t):
+#if PINKIE_CFG_PRINTF_MAX_INT >= 4
+        case sizeof(uint32_t):
+#endif
+#if PINKIE_CFG_PRINTF_MAX_INT >= 8
+        case sizeof(uint64_t):
+#endif
+            return REGREG_TYPE_WIDTH(type);
+    }
+
+    return sizeof(uint8_t);
+}
+#endif
@@ -16,10 +16,5 @@ int regreg_acyclic_init(
     struct ACYCLIC_T *a
 );
 
-uint16_t str_to_u16(
-    const char *str,                            /**< string */
-    unsigned int len                            /**< length */
-);
-
 
 #endif /* REGREG_ACYCLIC_H */
@@ -0,0 +1,242 @@
+/**
+ * @brief RegReg - Announcement queue
+ *
+ * Announcements are collected in a small queue and sent from the main loop
+ * by reg_ann_process(). An announcement that overlaps or directly follows the
+ * last queued record is merged into it, so consecutive register updates are
+ * sent as one multi-byte record. Only the last record is merged to keep the
+ * order in which the registers were announced.
+ *
+ * Optionally the host subscribes to register ranges by the subscription
+ * table. As long as a subscription is set, announcements outside of all
+ * subscribed ranges are dropped before they are queued. An announcement that
+ * overlaps a subscription is sent as a whole to keep multi-byte values
+ * intact.
+ *
+ * The application provides reg_ann_send() to output a record.
+ *
+ * Copyright (c) 2017, Sven Bachmann <dev@mcbachmann.de>
+ *
+ * Licensed under the MIT license, see LICENSE for details.
+ */
+#include <pinkie.h>
+#include <drv/timer/pinkie_timer.h>
+#include "regreg_ann.h"
+
+
+/*****************************************************************************/
+/* Local datatypes */
+/*****************************************************************************/
+/**< announcement record */
+typedef struct {
+    REG_ADDR_T addr;                            /**< start address */
+    uint8_t len;                                /**< data length */
+    uint8_t data[PINKIE_CFG_REGREG_ANN_LEN];    /**< data */
+} REGREG_ANN_REC_T;
+
+
+/*****************************************************************************/
+/* Local prototypes */
+/*****************************************************************************/
+static void reg_ann_send_first(
+    void
+);
+
+
+/*****************************************************************************/
+/* Local variables */
+/*****************************************************************************/
+static REGREG_ANN_REC_T ann_recs[PINKIE_CFG_REGREG_ANN_CNT]; /**< record queue */
+static uint8_t ann_rd = 0;                      /**< first record index */
+static uint8_t ann_cnt = 0;                     /**< queued record count */
+static uint64_t ann_ts;                         /**< first record timestamp or head change */
+
+/**< announcement queue register data */
+static REGREG_ANN_REG_T ann_regreg_data = {
+    PINKIE_CFG_REGREG_ANN_FLUSH_MS,             /* flush interval */
+    0,                                          /* overflow counter */
+#if PINKIE_CFG_REGREG_ANN_SUB_CNT > 0
+    0,                                          /* drop counter */
+    { { 0, 0 } },                               /* subscriptions */
+#endif
+};
+
+static REG_ENTRY_T ann_regreg_info =            /**< announcement queue register */
+    REGREG_ENTRY_INIT_TYPED(0, sizeof(REGREG_ANN_REG_T) - 1, NULL, &ann_regreg_data, NULL, REGREG_TYPE_U16);
+
+
+/*****************************************************************************/
+/** Announcement Queue Initialization
+ */
+unsigned int reg_ann_init(
+    REG_ADDR_T rr_base                          /**< regreg base address */
+)
+{
+    /* regreg base address */
+    ann_regreg_info.addr_beg = rr_base;
+    ann_regreg_info.addr_end = rr_base + sizeof(ann_regreg_data) - 1;
+
+    /* create RegReg registers */
+    return reg_add(&ann_regreg_info);
+}
+
+
+/*****************************************************************************/
+/** Announce register content to client
+ *
+ * Queues the data for the next flush. It doesn't internally update the
+ * register so a following read can produce other or no results. This depends
+ * on the caller.
+ */
+void reg_ann(
+    REG_ADDR_T addr,                            /**< register address */
+    void *data,                                 /**< data */
+    unsigned int len                            /**< data length */
+)
+{
+    const uint8_t *src = (const uint8_t *) data; /* source data */
+    REGREG_ANN_REC_T *rec;                      /* record */
+    REG_ADDR_T ofs;                             /* record offset */
+    unsigned int chunk;                         /* chunk length */
+
+#if PINKIE_CFG_REGREG_ANN_SUB_CNT > 0
+    /* drop unsubscribed announcements at the source */
+    if (!reg_ann_sub_match(addr, len)) {
+        ann_regreg_data.cnt_drop++;
+        return;
+    }
+#endif
+
+    while (len) {
+
+        /* merge data into last record if it overlaps or directly follows */
+        if (ann_cnt) {
+            rec = &ann_recs[(ann_rd + ann_cnt - 1) % PINKIE_CFG_REGREG_ANN_CNT];
+            ofs = (REG_ADDR_T) (addr - rec->addr);
+
+            if ((ofs <= rec->len) && (ofs < PINKIE_CFG_REGREG_ANN_LEN)) {
+                chunk = PINKIE_CFG_REGREG_ANN_LEN - ofs;
+                if (len < chunk) {
+                    chunk = len;
+                }
+
+                memcpy(&rec->data[ofs], src, chunk);
+                if (rec->len < (ofs + chunk)) {
+                    rec->len = ofs + chunk;
+                }
+
+                addr += chunk;
+                src += chunk;
+                len -= chunk;
+                continue;
+            }
+        }
+
+        /* queue full: send oldest record now */
+        if (PINKIE_CFG_REGREG_ANN_CNT <= ann_cnt) {
+            ann_regreg_data.cnt_overflow++;
+            reg_ann_send_first();
+        }
+
+        /* start new record */
+        if (!ann_cnt) {
+            ann_ts = pinkie_timer_get();
+        }
+
+        rec = &ann_recs[(ann_rd + ann_cnt) % PINKIE_CFG_REGREG_ANN_CNT];
+        rec->addr = addr;
+        rec->len = 0;
+        ann_cnt++;
+    }
+}
+
+
+/*****************************************************************************/
+/** Check if host subscribed to register range
+ *
+ * Callers can use it to skip preparing data that would be dropped anyway.
+ *
+ * @retval 1 range overlaps a subscription or no subscription is set
+ * @retval 0 range is not subscribed
+ */
+unsigned int reg_ann_sub_match(
+    REG_ADDR_T addr,                            /**< register address */
+    unsigned int len                            /**< data length */
+)
+{
+#if PINKIE_CFG_REGREG_ANN_SUB_CNT > 0
+    const REGREG_ANN_SUB_T *sub;                /* subscription */
+    unsigned int flg_sub = 0;                   /* subscription set flag */
+    unsigned int cnt;                           /* counter */
+
+    for (cnt = 0; cnt < PINKIE_CFG_REGREG_ANN_SUB_CNT; cnt++) {
+        sub = &ann_regreg_data.subs[cnt];
+        if (!sub->len) {
+            continue;
+        }
+        flg_sub = 1;
+
+        /* ranges overlap if one starts inside the other */
+        if (((REG_ADDR_T) (addr - sub->addr) < sub->len) ||
+            ((REG_ADDR_T) (sub->addr - addr) < len)) {
+            return 1;
+        }
+    }
+
+    return !flg_sub;
+#else
+    PINKIE_UNUSED(addr);
+    PINKIE_UNUSED(len);
+
+    return 1;
+#endif
+}
+
+
+/*****************************************************************************/
+/** Send and remove first record
+ *
+ * The flush interval restarts for the next record, so it isn't flushed early
+ * with the timestamp of the sent one.
+ */
+static void reg_ann_send_first(
+    void
+)
+{
+    reg_ann_send(ann_recs[ann_rd].addr, ann_recs[ann_rd].data, ann_recs[ann_rd].len);
+
+    ann_rd = (ann_rd + 1) % PINKIE_CFG_REGREG_ANN_CNT;
+    ann_cnt--;
+
+    if (ann_cnt) {
+        ann_ts = pinkie_timer_get();
+    }
+}
+
+
+/*****************************************************************************/
+/** Send all queued records
+ */
+void reg_ann_flush(
+    void
+)
+{
+    while (ann_cnt) {
+        reg_ann_send_first();
+    }
+}
+
+
+/*****************************************************************************/
+/** Announcement Queue Processor
+ *
+ * Flushes the queue if the oldest record waited for the flush interval.
+ */
+void reg_ann_process(
+    void
+)
+{
+    if ((ann_cnt) && ((pinkie_timer_get() - ann_ts) >= ann_regreg_data.flush_ms)) {
+        reg_ann_flush();
+    }
+}
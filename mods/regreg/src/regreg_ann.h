@@ -0,0 +1,97 @@
+/**
+ * @brief RegReg - Announcement queue
+ *
+ * Copyright (c) 2017, Sven Bachmann <dev@mcbachmann.de>
+ *
+ * Licensed under the MIT license, see LICENSE for details.
+ */
+#ifndef REGREG_ANN_H
+#define REGREG_ANN_H
+
+#include <regreg.h>
+
+
+/*****************************************************************************/
+/* Configuration */
+/*****************************************************************************/
+#ifndef PINKIE_CFG_REGREG_ANN_CNT
+#  define PINKIE_CFG_REGREG_ANN_CNT     4       /**< queued announcement records */
+#endif
+
+#ifndef PINKIE_CFG_REGREG_ANN_LEN
+#  define PINKIE_CFG_REGREG_ANN_LEN     8       /**< max bytes per record */
+#endif
+
+#ifndef PINKIE_CFG_REGREG_ANN_FLUSH_MS
+#  define PINKIE_CFG_REGREG_ANN_FLUSH_MS 20     /**< default flush interval */
+#endif
+
+#ifndef PINKIE_CFG_REGREG_ANN_SUB_CNT
+#  define PINKIE_CFG_REGREG_ANN_SUB_CNT 0       /**< host subscriptions (0 = announce all) */
+#endif
+
+
+/*****************************************************************************/
+/* Defines */
+/*****************************************************************************/
+#define REGREG_ANN_REG_FLUSH_MS         offsetof(REGREG_ANN_REG_T, flush_ms)
+#define REGREG_ANN_REG_CNT_OVERFLOW     offsetof(REGREG_ANN_REG_T, cnt_overflow)
+
+#if PINKIE_CFG_REGREG_ANN_SUB_CNT > 0
+#  define REGREG_ANN_REG_CNT_DROP       offsetof(REGREG_ANN_REG_T, cnt_drop)
+#  define REGREG_ANN_REG_SUBS           offsetof(REGREG_ANN_REG_T, subs)
+#endif
+
+
+/*****************************************************************************/
+/* Data types */
+/*****************************************************************************/
+/**< host subscription RegReg mapping
+ *
+ * Offsets are given for 16 bit addresses / PINKIE_CFG_REGREG_ADDR32.
+ */
+typedef struct {
+    REG_ADDR_T addr;                            /**< [rr:0-1 / 0-3] register start address */
+    REG_ADDR_T len;                             /**< [rr:2-3 / 4-7] register range length (0 = disabled) */
+} __attribute__((packed)) REGREG_ANN_SUB_T;
+
+
+/**< announcement queue RegReg mapping */
+typedef struct {
+    uint16_t flush_ms;                          /**< [rr:0-1] flush interval in ms */
+    uint16_t cnt_overflow;                      /**< [rr:2-3] queue overflow counter */
+#if PINKIE_CFG_REGREG_ANN_SUB_CNT > 0
+    uint16_t cnt_drop;                          /**< [rr:4-5] unsubscribed announcements */
+    REGREG_ANN_SUB_T subs[PINKIE_CFG_REGREG_ANN_SUB_CNT]; /**< [rr:6-] host subscriptions, 4 / 8 bytes each */
+#endif
+} __attribute__((packed)) REGREG_ANN_REG_T;
+
+
+/*****************************************************************************/
+/* Prototypes */
+/*****************************************************************************/
+unsigned int reg_ann_init(
+    REG_ADDR_T rr_base                          /**< regreg base address */
+);
+
+void reg_ann_process(
+    void
+);
+
+void reg_ann_flush(
+    void
+);
+
+unsigned int reg_ann_sub_match(
+    REG_ADDR_T addr,                            /**< register address */
+    unsigned int len                            /**< data length */
+);
+
+void reg_ann_send(
+    REG_ADDR_T addr,                            /**< register address */
+    const uint8_t *data,                        /**< data */
+    unsigned int len                            /**< data length */
+);
+
+
+#endif /* REGREG_ANN_H */
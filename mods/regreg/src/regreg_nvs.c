@@ -0,0 +1,171 @@
+/**
+ * @brief RegReg - Persistent registers
+ *
+ * Register entries flagged by REGREG_FLG_NVS keep their data inside the NVS
+ * image. Each write marks the changed bytes dirty and all changes are merged
+ * into one dirty range. reg_nvs_process() writes this range back once no
+ * further change happened for the quiet period. So a burst of writes, e.g. a
+ * full configuration, results in a single NVS update that only touches the
+ * changed bytes and the CRC.
+ *
+ * The CRC covers the whole image, so a partial update is only correct if the
+ * rest of the NVS already matches the image. While the NVS isn't valid, e.g.
+ * after defaults were loaded or the application invalidated it, the next
+ * write-back writes the whole image.
+ *
+ * Copyright (c) 2017, Sven Bachmann <dev@mcbachmann.de>
+ *
+ * Licensed under the MIT license, see LICENSE for details.
+ */
+#include <pinkie.h>
+#include <drv/nvs/pinkie_nvs.h>
+#include <drv/timer/pinkie_timer.h>
+#include "regreg_nvs.h"
+
+
+/*****************************************************************************/
+/* Local variables */
+/*****************************************************************************/
+static uint8_t *nvs_data = NULL;                /**< NVS image */
+static unsigned int nvs_len = 0;                /**< NVS image length */
+static unsigned int nvs_dirty_beg = 0;          /**< first dirty byte */
+static unsigned int nvs_dirty_end = 0;          /**< behind last dirty byte */
+static uint64_t nvs_ts;                         /**< last change timestamp */
+static unsigned int nvs_flg_valid = 0;          /**< NVS matches image flag */
+
+/**< persistent registers register data */
+static REGREG_NVS_REG_T nvs_regreg_data = {
+    PINKIE_CFG_REGREG_NVS_QUIET_MS,             /* quiet period */
+    0,                                          /* write-back counter */
+    0,                                          /* byte counter */
+};
+
+static REG_ENTRY_T nvs_regreg_info =            /**< persistent registers register */
+    REGREG_ENTRY_INIT_TYPED(0, sizeof(REGREG_NVS_REG_T) - 1, NULL, &nvs_regreg_data, NULL, REGREG_TYPE_U16);
+
+
+/*****************************************************************************/
+/** Persistent Registers Initialization
+ *
+ * The NVS image must start with the CRC as it is written by pinkie_nvs_write().
+ */
+unsigned int reg_nvs_init(
+    REG_ADDR_T rr_base,                         /**< regreg base address */
+    unsigned int flg_nvs_valid,                 /**< NVS data valid flag */
+    void *data,                                 /**< NVS image */
+    unsigned int len                            /**< NVS image length */
+)
+{
+    nvs_data = data;
+    nvs_len = len;
+    nvs_flg_valid = flg_nvs_valid;
+
+    /* regreg base address */
+    nvs_regreg_info.addr_beg = rr_base;
+    nvs_regreg_info.addr_end = rr_base + sizeof(nvs_regreg_data) - 1;
+
+    /* create RegReg registers */
+    return reg_add(&nvs_regreg_info);
+}
+
+
+/*****************************************************************************/
+/** Mark persistent data as changed
+ *
+ * Data outside of the NVS image is ignored.
+ */
+void reg_nvs_mark(
+    const void *data,                           /**< changed data */
+    unsigned int len                            /**< changed data length */
+)
+{
+    const uint8_t *ptr = data;                  /* data pointer */
+    unsigned int ofs;                           /* image offset */
+
+    if ((!nvs_data) || (!len) || (ptr < nvs_data) || (ptr >= &nvs_data[nvs_len])) {
+        return;
+    }
+
+    ofs = (unsigned int) (ptr - nvs_data);
+    if (len > (nvs_len - ofs)) {
+        len = nvs_len - ofs;
+    }
+
+    /* merge change into dirty range */
+    if (nvs_dirty_beg == nvs_dirty_end) {
+        nvs_dirty_beg = ofs;
+        nvs_dirty_end = ofs + len;
+    } else {
+        if (ofs < nvs_dirty_beg) {
+            nvs_dirty_beg = ofs;
+        }
+        if ((ofs + len) > nvs_dirty_end) {
+            nvs_dirty_end = ofs + len;
+        }
+    }
+
+    nvs_ts = pinkie_timer_get();
+}
+
+
+/*****************************************************************************/
+/** Write dirty range back to NVS
+ *
+ * Writes the whole image if the NVS isn't valid.
+ */
+void reg_nvs_flush(
+    void
+)
+{
+    if (nvs_dirty_beg == nvs_dirty_end) {
+        return;
+    }
+
+    if (nvs_flg_valid) {
+        pinkie_nvs_update(nvs_data, nvs_len, nvs_dirty_beg, nvs_dirty_end - nvs_dirty_beg);
+        nvs_regreg_data.cnt_byte += (uint16_t) (nvs_dirty_end - nvs_dirty_beg);
+    } else {
+        pinkie_nvs_write(nvs_data, nvs_len);
+        nvs_regreg_data.cnt_byte += (uint16_t) nvs_len;
+        nvs_flg_valid = 1;
+    }
+
+    nvs_regreg_data.cnt_flush++;
+
+    nvs_dirty_beg = 0;
+    nvs_dirty_end = 0;
+}
+
+
+/*****************************************************************************/
+/** Update NVS state after an application write
+ *
+ * Must be called if the application writes or invalidates the NVS itself.
+ * Pending changes are dropped: a full write already contains them and an
+ * invalidated NVS must not be revalidated by a partial update.
+ */
+void reg_nvs_sync(
+    unsigned int flg_nvs_valid                  /**< NVS data valid flag */
+)
+{
+    nvs_flg_valid = flg_nvs_valid;
+
+    nvs_dirty_beg = 0;
+    nvs_dirty_end = 0;
+}
+
+
+/*****************************************************************************/
+/** Persistent Registers Processor
+ *
+ * Writes the dirty range back if the last change is older than the quiet
+ * period.
+ */
+void reg_nvs_process(
+    void
+)
+{
+    if ((nvs_dirty_beg != nvs_dirty_end) && ((pinkie_timer_get() - nvs_ts) >= nvs_regreg_data.quiet_ms)) {
+        reg_nvs_flush();
+    }
+}
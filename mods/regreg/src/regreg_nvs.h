@@ -0,0 +1,68 @@
+/**
+ * @brief RegReg - Persistent registers
+ *
+ * Copyright (c) 2017, Sven Bachmann <dev@mcbachmann.de>
+ *
+ * Licensed under the MIT license, see LICENSE for details.
+ */
+#ifndef REGREG_NVS_H
+#define REGREG_NVS_H
+
+#include <regreg.h>
+
+#if PINKIE_CFG_REGREG_NVS == 0
+#  error "RegReg persistent registers require PINKIE_CFG_REGREG_NVS"
+#endif
+
+
+/*****************************************************************************/
+/* Configuration */
+/*****************************************************************************/
+#ifndef PINKIE_CFG_REGREG_NVS_QUIET_MS
+#  define PINKIE_CFG_REGREG_NVS_QUIET_MS 2000   /**< write-back delay after last change */
+#endif
+
+
+/*****************************************************************************/
+/* Defines */
+/*****************************************************************************/
+#define REGREG_NVS_REG_QUIET_MS         offsetof(REGREG_NVS_REG_T, quiet_ms)
+#define REGREG_NVS_REG_CNT_FLUSH        offsetof(REGREG_NVS_REG_T, cnt_flush)
+#define REGREG_NVS_REG_CNT_BYTE         offsetof(REGREG_NVS_REG_T, cnt_byte)
+
+
+/*****************************************************************************/
+/* Data types */
+/*****************************************************************************/
+/**< persistent registers RegReg mapping */
+typedef struct {
+    uint16_t quiet_ms;                          /**< [rr:0-1] write-back delay after last change */
+    uint16_t cnt_flush;                         /**< [rr:2-3] NVS write-backs */
+    uint16_t cnt_byte;                          /**< [rr:4-5] bytes passed to NVS */
+} __attribute__((packed)) REGREG_NVS_REG_T;
+
+
+/*****************************************************************************/
+/* Prototypes */
+/*****************************************************************************/
+unsigned int reg_nvs_init(
+    REG_ADDR_T rr_base,                         /**< regreg base address */
+    unsigned int flg_nvs_valid,                 /**< NVS data valid flag */
+    void *data,                                 /**< NVS image */
+    unsigned int len                            /**< NVS image length */
+);
+
+void reg_nvs_flush(
+    void
+);
+
+void reg_nvs_sync(
+    unsigned int flg_nvs_valid                  /**< NVS data valid flag */
+);
+
+void reg_nvs_process(
+    void
+);
+
+
+#endif /* REGREG_NVS_H */
@@ -0,0 +1,352 @@
+/**
+ * @brief RegReg - Remote register proxy
+ *
+ * A register window of a remote node is mounted on the local register bus.
+ * Accesses to the window are sent as request frames to the node, which
+ * executes them on its own registers and sends back a response.
+ *
+ * Reads are served from a window cache until its TTL expires. A cache miss
+ * requests the whole window at once and the access returns REGREG_RES_BUSY.
+ * The response fills the cache and announces the window, so the host gets
+ * the value without polling. While a request is outstanding every further
+ * access of the window is coalesced into it and also returns busy. This keeps
+ * the airtime of slow or duty-cycle limited links low. If no request can be
+ * sent, e.g. the send budget is exhausted, reads fall back to stale data.
+ *
+ * Writes are forwarded immediately and invalidate the cache. Busy writes are
+ * retried by the pending write queue if it is enabled.
+ *
+ * The application provides reg_proxy_send() to transmit a frame and passes
+ * received frames to reg_proxy_input(). Nodes only need reg_proxy_init() to
+ * answer requests.
+ *
+ * Copyright (c) 2017, Sven Bachmann <dev@mcbachmann.de>
+ *
+ * Licensed under the MIT license, see LICENSE for details.
+ */
+#include <pinkie.h>
+#include <string.h>
+#include <drv/timer/pinkie_timer.h>
+#include "regreg_proxy.h"
+
+
+/*****************************************************************************/
+/* Local prototypes */
+/*****************************************************************************/
+static unsigned int reg_proxy_regreg(
+    struct REG_ENTRY_T *reg,                    /**< register info */
+    struct REG_ACC_T *reg_acc                   /**< register access info */
+);
+
+static unsigned int reg_proxy_req(
+    REGREG_PROXY_T *proxy,                      /**< window */
+    uint8_t type,                               /**< request type */
+    uint16_t addr,                              /**< remote address */
+    const uint8_t *data,                        /**< write data or NULL */
+    uint8_t len                                 /**< data length */
+);
+
+static void reg_proxy_serve(
+    const REGREG_PROXY_FRM_T *frm               /**< request frame */
+);
+
+static void reg_proxy_rsp(
+    const REGREG_PROXY_FRM_T *frm               /**< response frame */
+);
+
+
+/*****************************************************************************/
+/* Local variables */
+/*****************************************************************************/
+static REGREG_PROXY_T *proxy_list = NULL;       /**< mounted windows */
+static uint8_t proxy_node = 0;                  /**< own node id */
+static uint8_t proxy_seq = 0;                   /**< last request sequence */
+static REGREG_PROXY_REG_T proxy_regreg_data;    /**< proxy statistics */
+
+static REG_ENTRY_T proxy_regreg_info =          /**< proxy statistics register */
+    REGREG_ENTRY_INIT_TYPED(0, sizeof(REGREG_PROXY_REG_T) - 1, NULL, &proxy_regreg_data, NULL, REGREG_TYPE_U16);
+
+
+/*****************************************************************************/
+/** Proxy Initialization
+ */
+unsigned int reg_proxy_init(
+    REG_ADDR_T rr_base,                         /**< regreg base address */
+    uint8_t node                                /**< own node id */
+)
+{
+    proxy_node = node;
+
+    /* regreg base address */
+    proxy_regreg_info.addr_beg = rr_base;
+    proxy_regreg_info.addr_end = rr_base + sizeof(proxy_regreg_data) - 1;
+
+    /* create RegReg registers */
+    return reg_add(&proxy_regreg_info);
+}
+
+
+/*****************************************************************************/
+/** Mount remote register window
+ *
+ * The window storage must stay valid as long as the window is mounted.
+ *
+ * @retval 0 successful
+ * @retval other failed
+ */
+unsigned int reg_proxy_mount(
+    REGREG_PROXY_T *proxy,                      /**< window storage */
+    REG_ADDR_T addr_beg,                        /**< local start address */
+    uint8_t len,                                /**< window length */
+    uint8_t node,                               /**< remote node */
+    uint16_t addr_remote,                       /**< remote start address */
+    uint16_t ttl_ms                             /**< cache time-to-live */
+)
+{
+    unsigned int res;                           /* result */
+
+    if ((!len) || (PINKIE_CFG_REGREG_PROXY_LEN < len) || ((uint16_t) (UINT16_MAX - addr_remote) < (len - 1))) {
+        return 1;
+    }
+
+    memset(proxy, 0, sizeof(REGREG_PROXY_T));
+    proxy->reg.addr_beg = addr_beg;
+    proxy->reg.addr_end = addr_beg + len - 1;
+    proxy->reg.cb = reg_proxy_regreg;
+    proxy->reg.data = proxy->data;
+    proxy->ttl_ms = ttl_ms;
+    proxy->addr_remote = addr_remote;
+    proxy->node = node;
+
+    res = reg_add(&proxy->reg);
+    if (res) {
+        return res;
+    }
+
+    proxy->next = proxy_list;
+    proxy_list = proxy;
+
+    return 0;
+}
+
+
+/*****************************************************************************/
+/** Send request for window
+ *
+ * @retval 0 successful
+ * @retval other failed
+ */
+static unsigned int reg_proxy_req(
+    REGREG_PROXY_T *proxy,                      /**< window */
+    uint8_t type,                               /**< request type */
+    uint16_t addr,                              /**< remote address */
+    const uint8_t *data,                        /**< write data or NULL */
+    uint8_t len                                 /**< data length */
+)
+{
+    REGREG_PROXY_FRM_T frm;                     /* request frame */
+
+    frm.type = type;
+    frm.dst = proxy->node;
+    frm.src = proxy_node;
+    frm.seq = ++proxy_seq;
+    frm.addr[0] = (uint8_t) addr;
+    frm.addr[1] = (uint8_t) (addr >> 8);
+    frm.len = len;
+    frm.res = 0;
+
+    if (data) {
+        memcpy(frm.data, data, len);
+    }
+
+    if (PINKIE_OK != reg_proxy_send((const uint8_t *) &frm, REGREG_PROXY_FRM_HDR_LEN + ((data) ? len : 0))) {
+        proxy_regreg_data.cnt_err++;
+        return 1;
+    }
+
+    proxy->seq = frm.seq;
+    proxy->req = type;
+    proxy->ts = pinkie_timer_get();
+    proxy_regreg_data.cnt_req++;
+
+    return 0;
+}
+
+
+/*****************************************************************************/
+/** Remote Window RegReg Handler
+ */
+static unsigned int reg_proxy_regreg(
+    struct REG_ENTRY_T *reg,                    /**< register info */
+    struct REG_ACC_T *reg_acc                   /**< register access info */
+)
+{
+    REGREG_PROXY_T *proxy = (REGREG_PROXY_T *) reg; /* window */
+
+    /* join outstanding request */
+    if (proxy->req) {
+        proxy_regreg_data.cnt_coalesce++;
+        return REGREG_RES_BUSY;
+    }
+
+    if (reg_acc->write_flg) {
+        proxy->flg_valid = 0;
+
+        return reg_proxy_req(proxy, REGREG_PROXY_FRM_WR,
+                             (uint16_t) (proxy->addr_remote + reg_acc->addr_ofs),
+                             reg_acc->data.read_from, (uint8_t) reg_acc->data_len);
+    }
+
+    if ((proxy->flg_valid) && ((pinkie_timer_get() - proxy->ts) < proxy->ttl_ms)) {
+        proxy_regreg_data.cnt_hit++;
+        return REGREG_RES_PROCEED;
+    }
+
+    /* request whole window */
+    if (reg_proxy_req(proxy, REGREG_PROXY_FRM_RD, proxy->addr_remote, NULL,
+                      (uint8_t) (reg->addr_end - reg->addr_beg + 1))) {
+        return (proxy->flg_valid) ? REGREG_RES_PROCEED : 1;
+    }
+
+    proxy->flg_valid = 0;
+
+    return REGREG_RES_BUSY;
+}
+
+
+/*****************************************************************************/
+/** Execute remote request on local registers
+ */
+static void reg_proxy_serve(
+    const REGREG_PROXY_FRM_T *frm               /**< request frame */
+)
+{
+    REGREG_PROXY_FRM_T rsp;                     /* response frame */
+    REG_ACC_T reg_acc;                          /* register access */
+
+    rsp.type = REGREG_PROXY_FRM_RSP;
+    rsp.dst = frm->src;
+    rsp.src = proxy_node;
+    rsp.seq = frm->seq;
+    rsp.addr[0] = frm->addr[0];
+    rsp.addr[1] = frm->addr[1];
+    rsp.len = 0;
+
+    reg_acc.addr = (REG_ADDR_T) (frm->addr[0] | (frm->addr[1] << 8));
+    reg_acc.data_len = frm->len;
+    reg_acc.write_flg = (REGREG_PROXY_FRM_WR == frm->type) ? 1 : 0;
+    if (reg_acc.write_flg) {
+        reg_acc.data.read_from = frm->data;
+    } else {
+        reg_acc.data.write_to = rsp.data;
+    }
+
+    rsp.res = (uint8_t) reg_rw(&reg_acc);
+    if ((!rsp.res) && (!reg_acc.write_flg)) {
+        rsp.len = frm->len;
+    }
+
+    if (PINKIE_OK != reg_proxy_send((const uint8_t *) &rsp, REGREG_PROXY_FRM_HDR_LEN + rsp.len)) {
+        proxy_regreg_data.cnt_err++;
+    }
+}
+
+
+/*****************************************************************************/
+/** Complete outstanding request
+ */
+static void reg_proxy_rsp(
+    const REGREG_PROXY_FRM_T *frm               /**< response frame */
+)
+{
+    REGREG_PROXY_T *proxy;                      /* window */
+    unsigned int len;                           /* window length */
+
+    for (proxy = proxy_list; proxy; proxy = proxy->next) {
+        if ((proxy->req) && (proxy->node == frm->src) && (proxy->seq == frm->seq)) {
+            break;
+        }
+    }
+
+    if (!proxy) {
+        return;
+    }
+
+    /* a remotely queued write is a success */
+    if ((frm->res) && (REGREG_RES_PENDING != frm->res)) {
+        proxy_regreg_data.cnt_err++;
+    }
+
+    len = proxy->reg.addr_end - proxy->reg.addr_beg + 1;
+    if ((REGREG_PROXY_FRM_RD == proxy->req) && (!frm->res) && (len == frm->len)) {
+        memcpy(proxy->data, frm->data, len);
+        proxy->flg_valid = 1;
+        proxy->ts = pinkie_timer_get();
+        reg_ann(proxy->reg.addr_beg, proxy->data, len);
+    }
+
+    proxy->req = 0;
+}
+
+
+/*****************************************************************************/
+/** Handle received frame
+ *
+ * Frames that are malformed or addressed to other nodes are ignored.
+ */
+void reg_proxy_input(
+    const uint8_t *data,                        /**< received frame */
+    unsigned int len                            /**< frame length */
+)
+{
+    REGREG_PROXY_FRM_T frm;                     /* aligned frame copy */
+
+    if ((REGREG_PROXY_FRM_HDR_LEN > len) || (sizeof(frm) < len)) {
+        return;
+    }
+    memcpy(&frm, data, len);
+
+    if ((frm.dst != proxy_node) || (PINKIE_CFG_REGREG_PROXY_LEN < frm.len)) {
+        return;
+    }
+
+    switch (frm.type) {
+
+        case REGREG_PROXY_FRM_RD:
+            reg_proxy_serve(&frm);
+            break;
+
+        case REGREG_PROXY_FRM_WR:
+            if ((REGREG_PROXY_FRM_HDR_LEN + frm.len) == len) {
+                reg_proxy_serve(&frm);
+            }
+            break;
+
+        case REGREG_PROXY_FRM_RSP:
+            if ((REGREG_PROXY_FRM_HDR_LEN + frm.len) == len) {
+                reg_proxy_rsp(&frm);
+            }
+            break;
+    }
+}
+
+
+/*****************************************************************************/
+/** Proxy Processor
+ *
+ * Drops requests without response after the timeout, so the next access
+ * sends a new request.
+ */
+void reg_proxy_process(
+    void
+)
+{
+    REGREG_PROXY_T *proxy;                      /* window */
+
+    for (proxy = proxy_list; proxy; proxy = proxy->next) {
+        if ((proxy->req) && ((pinkie_timer_get() - proxy->ts) >= PINKIE_CFG_REGREG_PROXY_TOUT_MS)) {
+            proxy->req = 0;
+            proxy_regreg_data.cnt_tout++;
+        }
+    }
+}
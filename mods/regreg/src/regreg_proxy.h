@@ -0,0 +1,127 @@
+/**
+ * @brief RegReg - Remote register proxy
+ *
+ * Copyright (c) 2017, Sven Bachmann <dev@mcbachmann.de>
+ *
+ * Licensed under the MIT license, see LICENSE for details.
+ */
+#ifndef REGREG_PROXY_H
+#define REGREG_PROXY_H
+
+#include <regreg.h>
+
+#if PINKIE_CFG_REGREG_CONCURRENT == 1
+#  error "RegReg proxy isn't supported in concurrent mode"
+#endif
+
+
+/*****************************************************************************/
+/* Configuration */
+/*****************************************************************************/
+#ifndef PINKIE_CFG_REGREG_PROXY_LEN
+#  define PINKIE_CFG_REGREG_PROXY_LEN   32      /**< max window length and frame payload */
+#endif
+
+#ifndef PINKIE_CFG_REGREG_PROXY_TOUT_MS
+#  define PINKIE_CFG_REGREG_PROXY_TOUT_MS 500   /**< response timeout */
+#endif
+
+#if PINKIE_CFG_REGREG_PROXY_LEN > 255
+#  error "RegReg proxy frame payload must fit into 255 bytes"
+#endif
+
+
+/*****************************************************************************/
+/* Defines */
+/*****************************************************************************/
+#define REGREG_PROXY_FRM_RD             1       /**< frame: read request */
+#define REGREG_PROXY_FRM_WR             2       /**< frame: write request */
+#define REGREG_PROXY_FRM_RSP            3       /**< frame: response */
+
+#define REGREG_PROXY_FRM_HDR_LEN        offsetof(REGREG_PROXY_FRM_T, data)
+
+#define REGREG_PROXY_REG_CNT_REQ        offsetof(REGREG_PROXY_REG_T, cnt_req)
+#define REGREG_PROXY_REG_CNT_HIT        offsetof(REGREG_PROXY_REG_T, cnt_hit)
+#define REGREG_PROXY_REG_CNT_COALESCE   offsetof(REGREG_PROXY_REG_T, cnt_coalesce)
+#define REGREG_PROXY_REG_CNT_TOUT       offsetof(REGREG_PROXY_REG_T, cnt_tout)
+#define REGREG_PROXY_REG_CNT_ERR        offsetof(REGREG_PROXY_REG_T, cnt_err)
+
+
+/*****************************************************************************/
+/* Data types */
+/*****************************************************************************/
+/**< proxy frame */
+typedef struct {
+    uint8_t type;                               /**< frame type (REGREG_PROXY_FRM_*) */
+    uint8_t dst;                                /**< destination node */
+    uint8_t src;                                /**< source node */
+    uint8_t seq;                                /**< request sequence number */
+    uint8_t addr[2];                            /**< remote address (little endian) */
+    uint8_t len;                                /**< data length */
+    uint8_t res;                                /**< response result */
+    uint8_t data[PINKIE_CFG_REGREG_PROXY_LEN];  /**< data */
+} __attribute__((packed)) REGREG_PROXY_FRM_T;
+
+
+/**< proxy statistics RegReg mapping */
+typedef struct {
+    uint16_t cnt_req;                           /**< [rr:0-1] sent requests */
+    uint16_t cnt_hit;                           /**< [rr:2-3] reads served from cache */
+    uint16_t cnt_coalesce;                      /**< [rr:4-5] accesses joined to outstanding request */
+    uint16_t cnt_tout;                          /**< [rr:6-7] response timeouts */
+    uint16_t cnt_err;                           /**< [rr:8-9] failed sends and remote errors */
+} __attribute__((packed)) REGREG_PROXY_REG_T;
+
+
+/**< mounted remote register window
+ *
+ * The register entry must stay the first member, as the register callback
+ * gets the window from its entry.
+ */
+typedef struct REGREG_PROXY_T {
+    REG_ENTRY_T reg;                            /**< local register entry */
+    struct REGREG_PROXY_T *next;                /**< next mounted window */
+    uint64_t ts;                                /**< cache fill or request timestamp */
+    uint16_t ttl_ms;                            /**< cache time-to-live */
+    uint16_t addr_remote;                       /**< remote start address */
+    uint8_t node;                               /**< remote node */
+    uint8_t seq;                                /**< outstanding request sequence */
+    uint8_t req;                                /**< outstanding request type (0 = none) */
+    uint8_t flg_valid;                          /**< cache valid flag */
+    uint8_t data[PINKIE_CFG_REGREG_PROXY_LEN];  /**< cached window data */
+} REGREG_PROXY_T;
+
+
+/*****************************************************************************/
+/* Prototypes */
+/*****************************************************************************/
+unsigned int reg_proxy_init(
+    REG_ADDR_T rr_base,                         /**< regreg base address */
+    uint8_t node                                /**< own node id */
+);
+
+unsigned int reg_proxy_mount(
+    REGREG_PROXY_T *proxy,                      /**< window storage */
+    REG_ADDR_T addr_beg,                        /**< local start address */
+    uint8_t len,                                /**< window length */
+    uint8_t node,                               /**< remote node */
+    uint16_t addr_remote,                       /**< remote start address */
+    uint16_t ttl_ms                             /**< cache time-to-live */
+);
+
+void reg_proxy_input(
+    const uint8_t *data,                        /**< received frame */
+    unsigned int len                            /**< frame length */
+);
+
+void reg_proxy_process(
+    void
+);
+
+PINKIE_RES_T reg_proxy_send(
+    const uint8_t *data,                        /**< frame */
+    unsigned int len                            /**< frame length */
+);
+
+
+#endif /* REGREG_PROXY_H */
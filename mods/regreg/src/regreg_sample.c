@@ -0,0 +1,147 @@
+/**
+ * @brief RegReg - Register sampling scheduler
+ *
+ * The sampling table is a list of jobs, each reading a register range with a
+ * fixed period and announcing the result. The table is mapped as registers and
+ * is part of the application NVS data, so the host configures it once and
+ * stores it with the other NVS settings.
+ *
+ * Jobs are scheduled on a fixed grid: the next deadline is the previous one
+ * plus the period. This keeps the sampling jitter bounded by the main loop
+ * latency. If a job falls behind by more than one period, the missed samples
+ * are skipped.
+ *
+ * Copyright (c) 2017, Sven Bachmann <dev@mcbachmann.de>
+ *
+ * Licensed under the MIT license, see LICENSE for details.
+ */
+#include <pinkie.h>
+#include <drv/timer/pinkie_timer.h>
+#include "regreg_sample.h"
+
+
+/*****************************************************************************/
+/* Local prototypes */
+/*****************************************************************************/
+static unsigned int reg_sample_regreg(
+    struct REG_ENTRY_T *reg,                    /**< register info */
+    struct REG_ACC_T *reg_acc                   /**< register access info */
+);
+
+
+/*****************************************************************************/
+/* Local variables */
+/*****************************************************************************/
+static REGREG_SAMPLE_NVS_T *sample_nvs;         /**< sampling table */
+static uint32_t sample_next[PINKIE_CFG_REGREG_SAMPLE_CNT]; /**< next deadline */
+static uint8_t sample_flg_sched[PINKIE_CFG_REGREG_SAMPLE_CNT]; /**< deadline valid flag */
+
+static REG_ENTRY_T sample_regreg_info =         /**< sampling table register */
+    REGREG_ENTRY_INIT(0, sizeof(REGREG_SAMPLE_NVS_T) - 1, reg_sample_regreg, NULL, NULL);
+
+
+/*****************************************************************************/
+/** Sampling Scheduler Initialization
+ */
+unsigned int reg_sample_init(
+    REG_ADDR_T rr_base,                         /**< regreg base address */
+    unsigned int flg_nvs_valid,                 /**< NVS data valid flag */
+    REGREG_SAMPLE_NVS_T *nvs                    /**< NVS data */
+)
+{
+    /* initialize NVS if not valid */
+    if (!flg_nvs_valid) {
+        memset(nvs, 0, sizeof(REGREG_SAMPLE_NVS_T));
+    }
+    sample_nvs = nvs;
+
+    /* regreg base address */
+    sample_regreg_info.addr_beg = rr_base;
+    sample_regreg_info.addr_end = rr_base + sizeof(REGREG_SAMPLE_NVS_T) - 1;
+    sample_regreg_info.data = nvs;
+#if PINKIE_CFG_REGREG_NVS == 1
+    sample_regreg_info.flg = REGREG_FLG_NVS;
+#endif
+
+    /* create RegReg registers */
+    return reg_add(&sample_regreg_info);
+}
+
+
+/*****************************************************************************/
+/** Sampling Table RegReg Handler
+ *
+ * Restarts the schedule of every job whose configuration is written.
+ */
+static unsigned int reg_sample_regreg(
+    struct REG_ENTRY_T *reg,                    /**< register info */
+    struct REG_ACC_T *reg_acc                   /**< register access info */
+)
+{
+    unsigned int idx;                           /* job index */
+
+    PINKIE_UNUSED(reg);
+
+    if (reg_acc->write_flg) {
+        for (idx = reg_acc->addr_ofs / sizeof(REGREG_SAMPLE_JOB_T);
+             idx <= (reg_acc->addr_ofs + reg_acc->data_len - 1u) / sizeof(REGREG_SAMPLE_JOB_T);
+             idx++) {
+            sample_flg_sched[idx] = 0;
+        }
+    }
+
+    return REGREG_RES_PROCEED;
+}
+
+
+/*****************************************************************************/
+/** Sampling Scheduler Processor
+ */
+void reg_sample_process(
+    void
+)
+{
+    unsigned int idx;                           /* job index */
+    uint32_t ts;                                /* timestamp */
+    uint8_t data[PINKIE_CFG_REGREG_SAMPLE_LEN]; /* register data */
+    REGREG_SAMPLE_JOB_T *job;                   /* sampling job */
+    REG_ACC_T reg_acc;                          /* register access */
+
+    ts = (uint32_t) pinkie_timer_get();
+
+    for (idx = 0; idx < PINKIE_CFG_REGREG_SAMPLE_CNT; idx++) {
+        job = &sample_nvs->jobs[idx];
+
+        /* skip disabled jobs */
+        if ((!job->len) || (PINKIE_CFG_REGREG_SAMPLE_LEN < job->len) || (!job->period_ms)) {
+            continue;
+        }
+
+        /* start schedule one period from now */
+        if (!sample_flg_sched[idx]) {
+            sample_next[idx] = ts + job->period_ms;
+            sample_flg_sched[idx] = 1;
+            continue;
+        }
+
+        if (0 > (int32_t) (ts - sample_next[idx])) {
+            continue;
+        }
+
+        /* advance on the fixed grid, skip missed samples */
+        sample_next[idx] += job->period_ms;
+        if (0 <= (int32_t) (ts - sample_next[idx])) {
+            sample_next[idx] = ts + job->period_ms;
+        }
+
+        /* read and announce register range */
+        reg_acc.addr = job->addr;
+        reg_acc.write_flg = 0;
+        reg_acc.data.write_to = data;
+        reg_acc.data_len = job->len;
+
+        if (!reg_rw(&reg_acc)) {
+            reg_ann(job->addr, data, job->len);
+        }
+    }
+}
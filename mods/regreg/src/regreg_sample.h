@@ -0,0 +1,68 @@
+/**
+ * @brief RegReg - Register sampling scheduler
+ *
+ * Copyright (c) 2017, Sven Bachmann <dev@mcbachmann.de>
+ *
+ * Licensed under the MIT license, see LICENSE for details.
+ */
+#ifndef REGREG_SAMPLE_H
+#define REGREG_SAMPLE_H
+
+#include <regreg.h>
+
+
+/*****************************************************************************/
+/* Configuration */
+/*****************************************************************************/
+#ifndef PINKIE_CFG_REGREG_SAMPLE_CNT
+#  define PINKIE_CFG_REGREG_SAMPLE_CNT  4       /**< sampling job count */
+#endif
+
+#ifndef PINKIE_CFG_REGREG_SAMPLE_LEN
+#  define PINKIE_CFG_REGREG_SAMPLE_LEN  8       /**< max register range per job */
+#endif
+
+
+/*****************************************************************************/
+/* Defines */
+/*****************************************************************************/
+#define REGREG_SAMPLE_REG_ADDR          offsetof(REGREG_SAMPLE_JOB_T, addr)
+#define REGREG_SAMPLE_REG_LEN           offsetof(REGREG_SAMPLE_JOB_T, len)
+#define REGREG_SAMPLE_REG_PERIOD_MS     offsetof(REGREG_SAMPLE_JOB_T, period_ms)
+
+
+/*****************************************************************************/
+/* Data types */
+/*****************************************************************************/
+/**< sampling job RegReg mapping
+ *
+ * Offsets are given for 16 bit addresses / PINKIE_CFG_REGREG_ADDR32.
+ */
+typedef struct {
+    REG_ADDR_T addr;                            /**< [rr:0-1 / 0-3] register start address */
+    uint8_t len;                                /**< [rr:2 / 4] register range length (0 = disabled) */
+    uint16_t period_ms;                         /**< [rr:3-4 / 5-6] sampling period in ms */
+} __attribute__((packed)) REGREG_SAMPLE_JOB_T;
+
+
+/**< sampling table non-volatile storage data */
+typedef struct {
+    REGREG_SAMPLE_JOB_T jobs[PINKIE_CFG_REGREG_SAMPLE_CNT]; /**< sampling jobs */
+} __attribute__((packed)) REGREG_SAMPLE_NVS_T;
+
+
+/*****************************************************************************/
+/* Prototypes */
+/*****************************************************************************/
+unsigned int reg_sample_init(
+    REG_ADDR_T rr_base,                         /**< regreg base address */
+    unsigned int flg_nvs_valid,                 /**< NVS data valid flag */
+    REGREG_SAMPLE_NVS_T *nvs                    /**< NVS data */
+);
+
+void reg_sample_process(
+    void
+);
+
+
+#endif /* REGREG_SAMPLE_H */
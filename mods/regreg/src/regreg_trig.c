@@ -0,0 +1,197 @@
+/**
+ * @brief RegReg - Register triggers
+ *
+ * A trigger watches a register and announces it if its value changed by more
+ * than a delta since the last announcement or if it crossed a threshold. The
+ * triggers are configured through registers and checked in the main loop by
+ * reg_trig_process(), each with its own interval.
+ *
+ * Values are read as 1 to 4 byte integers in device byte order (little
+ * endian). Writing a trigger configuration resets its state, so the next
+ * check only takes the current value as reference.
+ *
+ * Copyright (c) 2017, Sven Bachmann <dev@mcbachmann.de>
+ *
+ * Licensed under the MIT license, see LICENSE for details.
+ */
+#include <pinkie.h>
+#include <drv/timer/pinkie_timer.h>
+#include "regreg_trig.h"
+
+
+/*****************************************************************************/
+/* Local datatypes */
+/*****************************************************************************/
+/**< trigger state */
+typedef struct {
+    uint8_t flg_valid;                          /**< reference values valid */
+    uint32_t ts;                                /**< last check timestamp */
+    int32_t val_ann;                            /**< last announced value */
+    int32_t val_last;                           /**< last checked value */
+} REGREG_TRIG_STATE_T;
+
+
+/*****************************************************************************/
+/* Local prototypes */
+/*****************************************************************************/
+static unsigned int reg_trig_regreg(
+    struct REG_ENTRY_T *reg,                    /**< register info */
+    struct REG_ACC_T *reg_acc                   /**< register access info */
+);
+
+static unsigned int reg_trig_check(
+    REGREG_TRIG_REG_T *trig,                    /**< trigger config */
+    REGREG_TRIG_STATE_T *state                  /**< trigger state */
+);
+
+
+/*****************************************************************************/
+/* Local variables */
+/*****************************************************************************/
+static REGREG_TRIG_REG_T trig_regreg_data[PINKIE_CFG_REGREG_TRIG_CNT]; /**< trigger config */
+static REGREG_TRIG_STATE_T trig_state[PINKIE_CFG_REGREG_TRIG_CNT]; /**< trigger state */
+
+static REG_ENTRY_T trig_regreg_info =           /**< trigger register */
+    REGREG_ENTRY_INIT(0, sizeof(trig_regreg_data) - 1, reg_trig_regreg, trig_regreg_data, NULL);
+
+
+/*****************************************************************************/
+/** Register Trigger Initialization
+ */
+unsigned int reg_trig_init(
+    REG_ADDR_T rr_base                          /**< regreg base address */
+)
+{
+    /* regreg base address */
+    trig_regreg_info.addr_beg = rr_base;
+    trig_regreg_info.addr_end = rr_base + sizeof(trig_regreg_data) - 1;
+
+    /* create RegReg registers */
+    return reg_add(&trig_regreg_info);
+}
+
+
+/*****************************************************************************/
+/** Register Trigger RegReg Handler
+ *
+ * Resets the state of every trigger whose configuration is written.
+ */
+static unsigned int reg_trig_regreg(
+    struct REG_ENTRY_T *reg,                    /**< register info */
+    struct REG_ACC_T *reg_acc                   /**< register access info */
+)
+{
+    unsigned int idx;                           /* trigger index */
+
+    PINKIE_UNUSED(reg);
+
+    if (reg_acc->write_flg) {
+        for (idx = reg_acc->addr_ofs / sizeof(REGREG_TRIG_REG_T);
+             idx <= (reg_acc->addr_ofs + reg_acc->data_len - 1u) / sizeof(REGREG_TRIG_REG_T);
+             idx++) {
+            trig_state[idx].flg_valid = 0;
+        }
+    }
+
+    return REGREG_RES_PROCEED;
+}
+
+
+/*****************************************************************************/
+/** Check a single trigger
+ *
+ * @returns 1 if the register must be announced, 0 otherwise
+ */
+static unsigned int reg_trig_check(
+    REGREG_TRIG_REG_T *trig,                    /**< trigger config */
+    REGREG_TRIG_STATE_T *state                  /**< trigger state */
+)
+{
+    uint8_t data[sizeof(uint32_t)];             /* register data */
+    uint32_t val_raw = 0;                       /* raw value */
+    int32_t val;                                /* value */
+    int32_t thres;                              /* threshold */
+    unsigned int res = 0;                       /* result */
+    unsigned int cnt;                           /* counter */
+    REG_ACC_T reg_acc;                          /* register access */
+
+    reg_acc.addr = trig->addr;
+    reg_acc.write_flg = 0;
+    reg_acc.data.write_to = data;
+    reg_acc.data_len = trig->len;
+
+    /* skip check if register isn't available, e.g. busy */
+    if (reg_rw(&reg_acc)) {
+        return 0;
+    }
+
+    /* convert little endian value */
+    for (cnt = trig->len; cnt; cnt--) {
+        val_raw = (val_raw << 8) | data[cnt - 1];
+    }
+
+    /* unsigned values are compared as 32-bit signed, large values may wrap */
+    val = (int32_t) val_raw;
+    thres = (int32_t) trig->thres;
+    if ((trig->mode & REGREG_TRIG_MODE_SIGNED) && (sizeof(uint32_t) > trig->len)) {
+        cnt = (sizeof(uint32_t) - trig->len) * 8;
+        val = (int32_t) (val_raw << cnt) >> cnt;
+    }
+
+    /* first check only stores the reference */
+    if (!state->flg_valid) {
+        state->flg_valid = 1;
+        state->val_ann = val;
+        state->val_last = val;
+        return 0;
+    }
+
+    /* change larger than delta since last announcement */
+    if ((trig->mode & REGREG_TRIG_MODE_DELTA) &&
+        (((val > state->val_ann) ? ((uint32_t) val - (uint32_t) state->val_ann) : ((uint32_t) state->val_ann - (uint32_t) val)) > trig->delta)) {
+        res = 1;
+    }
+
+    /* threshold crossed in any direction */
+    if ((trig->mode & REGREG_TRIG_MODE_THRES) &&
+        ((state->val_last < thres) != (val < thres))) {
+        res = 1;
+    }
+
+    state->val_last = val;
+    if (res) {
+        state->val_ann = val;
+        reg_ann(trig->addr, data, trig->len);
+    }
+
+    return res;
+}
+
+
+/*****************************************************************************/
+/** Register Trigger Processor
+ */
+void reg_trig_process(
+    void
+)
+{
+    unsigned int idx;                           /* trigger index */
+    uint32_t ts;                                /* timestamp */
+
+    ts = (uint32_t) pinkie_timer_get();
+
+    for (idx = 0; idx < PINKIE_CFG_REGREG_TRIG_CNT; idx++) {
+
+        /* skip disabled triggers */
+        if ((!trig_regreg_data[idx].len) || (sizeof(uint32_t) < trig_regreg_data[idx].len)) {
+            continue;
+        }
+
+        if ((trig_state[idx].flg_valid) && ((ts - trig_state[idx].ts) < trig_regreg_data[idx].interval_ms)) {
+            continue;
+        }
+
+        trig_state[idx].ts = ts;
+        reg_trig_check(&trig_regreg_data[idx], &trig_state[idx]);
+    }
+}
@@ -0,0 +1,66 @@
+/**
+ * @brief RegReg - Register triggers
+ *
+ * Copyright (c) 2017, Sven Bachmann <dev@mcbachmann.de>
+ *
+ * Licensed under the MIT license, see LICENSE for details.
+ */
+#ifndef REGREG_TRIG_H
+#define REGREG_TRIG_H
+
+#include <regreg.h>
+
+
+/*****************************************************************************/
+/* Configuration */
+/*****************************************************************************/
+#ifndef PINKIE_CFG_REGREG_TRIG_CNT
+#  define PINKIE_CFG_REGREG_TRIG_CNT    4       /**< trigger count */
+#endif
+
+
+/*****************************************************************************/
+/* Defines */
+/*****************************************************************************/
+#define REGREG_TRIG_MODE_DELTA          (1 << 0) /**< announce on change larger than delta */
+#define REGREG_TRIG_MODE_THRES          (1 << 1) /**< announce on threshold crossing */
+#define REGREG_TRIG_MODE_SIGNED         (1 << 2) /**< value is signed */
+
+#define REGREG_TRIG_REG_ADDR            offsetof(REGREG_TRIG_REG_T, addr)
+#define REGREG_TRIG_REG_LEN             offsetof(REGREG_TRIG_REG_T, len)
+#define REGREG_TRIG_REG_MODE            offsetof(REGREG_TRIG_REG_T, mode)
+#define REGREG_TRIG_REG_INTERVAL_MS     offsetof(REGREG_TRIG_REG_T, interval_ms)
+#define REGREG_TRIG_REG_DELTA           offsetof(REGREG_TRIG_REG_T, delta)
+#define REGREG_TRIG_REG_THRES           offsetof(REGREG_TRIG_REG_T, thres)
+
+
+/*****************************************************************************/
+/* Data types */
+/*****************************************************************************/
+/**< register trigger RegReg mapping (one block per trigger)
+ *
+ * Offsets are given for 16 bit addresses / PINKIE_CFG_REGREG_ADDR32.
+ */
+typedef struct {
+    REG_ADDR_T addr;                            /**< [rr:0-1 / 0-3] watched register address */
+    uint8_t len;                                /**< [rr:2 / 4] value width 1-4 (0 = disabled) */
+    uint8_t mode;                               /**< [rr:3 / 5] mode flags */
+    uint16_t interval_ms;                       /**< [rr:4-5 / 6-7] check interval in ms */
+    uint32_t delta;                             /**< [rr:6-9 / 8-11] change delta */
+    uint32_t thres;                             /**< [rr:10-13 / 12-15] threshold */
+} __attribute__((packed)) REGREG_TRIG_REG_T;
+
+
+/*****************************************************************************/
+/* Prototypes */
+/*****************************************************************************/
+unsigned int reg_trig_init(
+    REG_ADDR_T rr_base                          /**< regreg base address */
+);
+
+void reg_trig_process(
+    void
+);
+
+
+#endif /* REGREG_TRIG_H */
@@ -0,0 +1,263 @@
+/**
+ * @brief RegReg - Transactions
+ *
+ * While a transaction is active, writes to its context are not executed. They
+ * are recorded byte by byte in a shadow log, and a later write to the same
+ * address replaces the staged byte. On commit, the log is sorted by address
+ * and every contiguous run inside a register entry is written with a single
+ * reg_ctx_rw() call. So callbacks with side effects, like SPI or NVS
+ * writes, run once per batch instead of once per byte.
+ *
+ * Reads during a transaction return the committed values. Log overflow marks
+ * the transaction as failed and the commit discards it.
+ *
+ * The transaction is controlled by registers (begin, commit, abort) or by
+ * the C API. Writes to the control register itself are never staged.
+ *
+ * Copyright (c) 2017, Sven Bachmann <dev@mcbachmann.de>
+ *
+ * Licensed under the MIT license, see LICENSE for details.
+ */
+#include <pinkie.h>
+#include "regreg_txn.h"
+
+
+/*****************************************************************************/
+/* Local datatypes */
+/*****************************************************************************/
+/**< staged byte */
+typedef struct {
+    REG_ADDR_T addr;                            /**< register address */
+    uint8_t val;                                /**< value */
+} REGREG_TXN_BYTE_T;
+
+
+/*****************************************************************************/
+/* Local prototypes */
+/*****************************************************************************/
+static unsigned int reg_txn_regreg(
+    struct REG_ENTRY_T *reg,                    /**< register info */
+    struct REG_ACC_T *reg_acc                   /**< register access info */
+);
+
+
+/*****************************************************************************/
+/* Local variables */
+/*****************************************************************************/
+static REGREG_CTX_T *txn_ctx = NULL;            /**< transaction context */
+static uint8_t txn_flg_fail = 0;                /**< transaction failed flag */
+static REGREG_TXN_BYTE_T txn_log[PINKIE_CFG_REGREG_TXN_LEN]; /**< shadow byte log */
+static REGREG_TXN_REG_T txn_regreg_data;        /**< transaction register data */
+
+static REG_ENTRY_T txn_regreg_info =            /**< transaction register */
+    REGREG_ENTRY_INIT(0, sizeof(REGREG_TXN_REG_T) - 1, reg_txn_regreg, &txn_regreg_data, NULL);
+
+
+/*****************************************************************************/
+/** Transaction Initialization
+ */
+unsigned int reg_txn_init(
+    REG_ADDR_T rr_base                          /**< regreg base address */
+)
+{
+    /* regreg base address */
+    txn_regreg_info.addr_beg = rr_base;
+    txn_regreg_info.addr_end = rr_base + sizeof(txn_regreg_data) - 1;
+
+    /* create RegReg registers */
+    return reg_add(&txn_regreg_info);
+}
+
+
+/*****************************************************************************/
+/** Begin transaction
+ *
+ * A running transaction is discarded.
+ */
+void reg_txn_begin(
+    REGREG_CTX_T *ctx                           /**< register context */
+)
+{
+    txn_ctx = ctx;
+    txn_flg_fail = 0;
+    txn_regreg_data.cnt = 0;
+}
+
+
+/*****************************************************************************/
+/** Abort transaction
+ */
+void reg_txn_abort(
+    void
+)
+{
+    txn_ctx = NULL;
+    txn_regreg_data.cnt = 0;
+}
+
+
+/*****************************************************************************/
+/** Stage write access
+ *
+ * Called by reg_ctx_rw() for every write.
+ *
+ * @retval REGREG_RES_PROCEED no transaction, execute write
+ * @retval 0 write staged
+ * @retval REGREG_RES_FULL log overflow, transaction failed
+ */
+unsigned int reg_txn_stage(
+    REGREG_CTX_T *ctx,                          /**< register context */
+    REG_ACC_T *reg_acc                          /**< register access info */
+)
+{
+    unsigned int cnt;                           /* counter */
+    unsigned int pos;                           /* log position */
+    REG_ADDR_T addr;                            /* register address */
+
+    if (txn_ctx != ctx) {
+        return REGREG_RES_PROCEED;
+    }
+
+    /* control register writes are never staged */
+    if ((reg_acc->addr >= txn_regreg_info.addr_beg) && (reg_acc->addr <= txn_regreg_info.addr_end)) {
+        return REGREG_RES_PROCEED;
+    }
+
+    for (cnt = 0; cnt < reg_acc->data_len; cnt++) {
+        addr = reg_acc->addr + cnt;
+
+        /* replace already staged byte */
+        for (pos = 0; (pos < txn_regreg_data.cnt) && (txn_log[pos].addr != addr); pos++);
+
+        if (pos == txn_regreg_data.cnt) {
+            if (PINKIE_CFG_REGREG_TXN_LEN <= txn_regreg_data.cnt) {
+                txn_flg_fail = 1;
+                return REGREG_RES_FULL;
+            }
+
+            txn_regreg_data.cnt++;
+        }
+
+        txn_log[pos].addr = addr;
+        txn_log[pos].val = reg_acc->data.read_from[cnt];
+    }
+
+    return 0;
+}
+
+
+/*****************************************************************************/
+/** Commit transaction
+ *
+ * @returns count of failed writes, or REGREG_RES_FULL if the log overflowed
+ */
+unsigned int reg_txn_commit(
+    void
+)
+{
+    REGREG_CTX_T *ctx = txn_ctx;                /* transaction context */
+    unsigned int cnt_err = 0;                   /* error counter */
+    unsigned int res;                           /* result */
+    unsigned int cnt;                           /* counter */
+    unsigned int pos;                           /* log position */
+    unsigned int pos_end;                       /* run end */
+    uint8_t data[PINKIE_CFG_REGREG_TXN_LEN];    /* run data */
+    REGREG_TXN_BYTE_T byte;                     /* sort buffer */
+    REG_ENTRY_T *reg;                           /* register */
+    REG_ENTRY_T buf;                            /* static entry buffer */
+    REG_ACC_T reg_acc;                          /* register access */
+
+    /* end transaction before writing, so the writes aren't staged again */
+    txn_ctx = NULL;
+
+    if ((!ctx) || (txn_flg_fail)) {
+        txn_regreg_data.cnt = 0;
+        return REGREG_RES_FULL;
+    }
+
+    /* sort log by address */
+    for (pos = 1; pos < txn_regreg_data.cnt; pos++) {
+        byte = txn_log[pos];
+        for (cnt = pos; (cnt) && (txn_log[cnt - 1].addr > byte.addr); cnt--) {
+            txn_log[cnt] = txn_log[cnt - 1];
+        }
+        txn_log[cnt] = byte;
+    }
+
+    /* write each contiguous run inside a register entry at once */
+    for (pos = 0; pos < txn_regreg_data.cnt; pos = pos_end) {
+        reg = reg_ctx_find(ctx, txn_log[pos].addr, &buf);
+
+        data[0] = txn_log[pos].val;
+        for (pos_end = pos + 1; pos_end < txn_regreg_data.cnt; pos_end++) {
+            if ((!reg) ||
+                (txn_log[pos_end].addr != (txn_log[pos_end - 1].addr + 1)) ||
+                (txn_log[pos_end].addr > reg->addr_end)) {
+                break;
+            }
+            data[pos_end - pos] = txn_log[pos_end].val;
+        }
+
+        reg_acc.addr = txn_log[pos].addr;
+        reg_acc.write_flg = 1;
+        reg_acc.data.read_from = data;
+        reg_acc.data_len = pos_end - pos;
+
+        /* queued writes complete later */
+        res = reg_ctx_rw(ctx, &reg_acc);
+        if ((res) && (REGREG_RES_PENDING != res)) {
+            cnt_err++;
+        }
+    }
+
+    txn_regreg_data.cnt = 0;
+
+    return cnt_err;
+}
+
+
+/*****************************************************************************/
+/** Transaction RegReg Handler
+ */
+static unsigned int reg_txn_regreg(
+    struct REG_ENTRY_T *reg,                    /**< register info */
+    struct REG_ACC_T *reg_acc                   /**< register access info */
+)
+{
+    unsigned int res;                           /* result */
+
+    PINKIE_UNUSED(reg);
+
+    if ((!reg_acc->write_flg) || (REGREG_TXN_REG_CTRL != reg_acc->addr_ofs)) {
+        return (reg_acc->write_flg) ? 1 : REGREG_RES_PROCEED;
+    }
+
+    /* only handle the control byte */
+    reg_acc->data_len = 1;
+
+    switch (*reg_acc->data.read_from) {
+
+        case REGREG_TXN_CTRL_BEGIN:
+            reg_txn_begin(reg_ctx_dfl_get());
+            break;
+
+        case REGREG_TXN_CTRL_COMMIT:
+            res = reg_txn_commit();
+            txn_regreg_data.cnt_err = (uint8_t) res;
+            if (res) {
+                return 1;
+            }
+            break;
+
+        case REGREG_TXN_CTRL_ABORT:
+            reg_txn_abort();
+            break;
+
+        default:
+            return 1;
+    }
+
+    txn_regreg_data.ctrl = (txn_ctx) ? REGREG_TXN_CTRL_BEGIN : REGREG_TXN_CTRL_NONE;
+
+    return 0;
+}
@@ -0,0 +1,66 @@
+/**
+ * @brief RegReg - Transactions
+ *
+ * Copyright (c) 2017, Sven Bachmann <dev@mcbachmann.de>
+ *
+ * Licensed under the MIT license, see LICENSE for details.
+ */
+#ifndef REGREG_TXN_H
+#define REGREG_TXN_H
+
+#include <regreg.h>
+
+#if PINKIE_CFG_REGREG_TXN_LEN == 0
+#  error "RegReg transactions require PINKIE_CFG_REGREG_TXN_LEN"
+#endif
+
+#if PINKIE_CFG_REGREG_TXN_LEN > 255
+#  error "PINKIE_CFG_REGREG_TXN_LEN exceeds the 8 bit staged byte counter"
+#endif
+
+
+/*****************************************************************************/
+/* Defines */
+/*****************************************************************************/
+#define REGREG_TXN_CTRL_NONE            0       /**< no transaction */
+#define REGREG_TXN_CTRL_BEGIN           1       /**< begin transaction */
+#define REGREG_TXN_CTRL_COMMIT          2       /**< commit transaction */
+#define REGREG_TXN_CTRL_ABORT           3       /**< abort transaction */
+
+#define REGREG_TXN_REG_CTRL             offsetof(REGREG_TXN_REG_T, ctrl)
+#define REGREG_TXN_REG_CNT              offsetof(REGREG_TXN_REG_T, cnt)
+#define REGREG_TXN_REG_CNT_ERR          offsetof(REGREG_TXN_REG_T, cnt_err)
+
+
+/*****************************************************************************/
+/* Data types */
+/*****************************************************************************/
+/**< transaction RegReg mapping */
+typedef struct {
+    uint8_t ctrl;                               /**< [rr:0] control (begin, commit, abort) */
+    uint8_t cnt;                                /**< [rr:1] staged bytes */
+    uint8_t cnt_err;                            /**< [rr:2] failed writes of last commit */
+} __attribute__((packed)) REGREG_TXN_REG_T;
+
+
+/*****************************************************************************/
+/* Prototypes */
+/*****************************************************************************/
+unsigned int reg_txn_init(
+    REG_ADDR_T rr_base                          /**< regreg base address */
+);
+
+void reg_txn_begin(
+    REGREG_CTX_T *ctx                           /**< register context */
+);
+
+unsigned int reg_txn_commit(
+    void
+);
+
+void reg_txn_abort(
+    void
+);
+
+
+#endif /* REGREG_TXN_H */
@@ -0,0 +1,211 @@
+#!/usr/bin/env python3
+#
+# PINKIE - RegReg Static Table Sort
+#
+# Sorts the static register table of a linked PINKIE application by address
+# and checks it for overlapping ranges. The linker collects the entries in
+# link order, so this runs as a build step after linking. Entries are moved
+# inside the ELF file together with their symbols and relocations, so
+# reg_init() always finds a sorted table and uses the binary search.
+#
+# Usage: regreg_tbl.py ELF
+#
+# Copyright (c) 2017, Sven Bachmann <dev@mcbachmann.de>
+#
+# Licensed under the MIT license, see LICENSE for details.
+#
+import struct
+import sys
+
+
+TBL_START = "__start_regreg_tbl"                # table start symbol
+TBL_STOP = "__stop_regreg_tbl"                  # table end symbol
+TBL_ADDR_LEN = "regreg_tbl_addr_len"            # register address width symbol
+
+SHT_SYMTAB = 2                                  # ELF symbol table section
+SHT_RELA = 4                                    # ELF relocations with addend
+SHT_NOBITS = 8                                  # ELF section without file data
+SHT_REL = 9                                     # ELF relocations
+SHT_RELR = 19                                   # ELF packed relative relocations
+SHF_ALLOC = 2                                   # ELF section is loaded
+STT_OBJECT = 1                                  # ELF data object symbol
+
+
+class Elf:
+    """Minimal little endian ELF reader and patcher"""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = bytearray(f.read())
+
+        if self.data[:4] != b"\x7fELF":
+            raise ValueError("%s: not an ELF file" % path)
+
+        if self.data[5] != 1:
+            raise ValueError("%s: only little endian ELF files are supported" % path)
+
+        self.is64 = (self.data[4] == 2)
+        if self.is64:
+            shoff, = struct.unpack_from("<Q", self.data, 0x28)
+            shentsize, shnum = struct.unpack_from("<HH", self.data, 0x3a)
+        else:
+            shoff, = struct.unpack_from("<I", self.data, 0x20)
+            shentsize, shnum = struct.unpack_from("<HH", self.data, 0x2e)
+
+        self.sections = []
+        self.flags = []
+        for idx in range(shnum):
+            ofs = shoff + idx * shentsize
+            if self.is64:
+                _, sh_type, sh_flags, sh_addr, sh_offset, sh_size, sh_link, _, _, sh_entsize = \
+                    struct.unpack_from("<IIQQQQIIQQ", self.data, ofs)
+            else:
+                _, sh_type, sh_flags, sh_addr, sh_offset, sh_size, sh_link, _, _, sh_entsize = \
+                    struct.unpack_from("<IIIIIIIIII", self.data, ofs)
+            self.sections.append((sh_type, sh_addr, sh_offset, sh_size, sh_link, sh_entsize))
+            self.flags.append(sh_flags)
+
+    def symbols(self):
+        """Yield name, value, size, type and file offset of all symbols"""
+        for sh_type, _, sh_offset, sh_size, sh_link, sh_entsize in self.sections:
+            if sh_type != SHT_SYMTAB:
+                continue
+
+            str_offset = self.sections[sh_link][2]
+            for ofs in range(sh_offset, sh_offset + sh_size, sh_entsize):
+                if self.is64:
+                    st_name, st_info, _, _, st_value, st_size = struct.unpack_from("<IBBHQQ", self.data, ofs)
+                else:
+                    st_name, st_value, st_size, st_info, _, _ = struct.unpack_from("<IIIBBH", self.data, ofs)
+
+                end = self.data.index(b"\0", str_offset + st_name)
+                yield self.data[str_offset + st_name:end].decode(), st_value, st_size, st_info & 0xf, ofs
+
+    def set_symbol(self, ofs, value):
+        """Change symbol value"""
+        if self.is64:
+            struct.pack_into("<Q", self.data, ofs + 8, value)
+        else:
+            struct.pack_into("<I", self.data, ofs + 4, value)
+
+    def relocations(self):
+        """Yield file offset and target address of all relocations"""
+        for sh_type, _, sh_offset, sh_size, _, sh_entsize in self.sections:
+            if sh_type not in (SHT_REL, SHT_RELA):
+                continue
+
+            for ofs in range(sh_offset, sh_offset + sh_size, sh_entsize):
+                yield ofs, struct.unpack_from("<Q" if self.is64 else "<I", self.data, ofs)[0]
+
+    def set_relocation(self, ofs, addr):
+        """Change relocation target address"""
+        struct.pack_into("<Q" if self.is64 else "<I", self.data, ofs, addr)
+
+    def has_relr(self):
+        """Check for packed relative relocations"""
+        return any(sec[0] == SHT_RELR and sec[3] for sec in self.sections)
+
+    def offset(self, addr):
+        """Get file offset of address"""
+        for (sh_type, sh_addr, sh_offset, sh_size, _, _), sh_flags in zip(self.sections, self.flags):
+            if (sh_type != SHT_NOBITS) and (sh_flags & SHF_ALLOC) and (sh_addr <= addr < sh_addr + sh_size):
+                return sh_offset + addr - sh_addr
+
+        raise ValueError("address 0x%x isn't part of the file" % addr)
+
+    def write(self, path):
+        with open(path, "wb") as f:
+            f.write(self.data)
+
+
+def tbl_sort(path):
+    """Sort and check static register table
+
+    @returns 0 on success, 1 on overlapping or unknown entries
+    """
+    elf = Elf(path)
+    syms = list(elf.symbols())
+    addrs = dict((sym[0], sym[1]) for sym in syms if sym[0] in (TBL_START, TBL_STOP, TBL_ADDR_LEN))
+
+    start = addrs.get(TBL_START)
+    stop = addrs.get(TBL_STOP)
+    if (start is None) or (stop is None) or (start == stop):
+        return 0
+
+    addr_len = addrs.get(TBL_ADDR_LEN)
+    if addr_len not in (2, 4):
+        sys.stderr.write("%s: missing %s\n" % (path, TBL_ADDR_LEN))
+        return 1
+
+    # entries are the data objects inside the table
+    names = {}
+    size = None
+    for name, value, st_size, st_type, _ in syms:
+        if (STT_OBJECT == st_type) and st_size and (start <= value < stop):
+            names[value] = name
+            size = st_size
+
+    if (not size) or ((stop - start) % size) or (len(names) != (stop - start) // size):
+        sys.stderr.write("%s: can't identify the static register table entries\n" % path)
+        return 1
+
+    cnt = (stop - start) // size
+    fmt = "<H" if addr_len == 2 else "<I"
+    base = elf.offset(start)
+    recs = []
+    for idx in range(cnt):
+        rec = bytes(elf.data[base + idx * size:base + (idx + 1) * size])
+        beg, = struct.unpack_from(fmt, rec, 0)
+        end, = struct.unpack_from(fmt, rec, addr_len)
+        recs.append((beg, end, names.get(start + idx * size, "?"), rec))
+
+    order = sorted(range(cnt), key=lambda idx: recs[idx][0])
+
+    # sorted ranges must not overlap
+    for prev, cur in zip(order, order[1:]):
+        if recs[prev][1] >= recs[cur][0]:
+            sys.stderr.write("%s: register %s (%u-%u) overlaps %s (%u-%u)\n" %
+                             (path, recs[prev][2], recs[prev][0], recs[prev][1],
+                              recs[cur][2], recs[cur][0], recs[cur][1]))
+            return 1
+
+    if order == list(range(cnt)):
+        return 0
+
+    if elf.has_relr():
+        sys.stderr.write("%s: can't sort the static register table with packed relocations\n" % path)
+        return 1
+
+    # move entries, their symbols and relocations to the sorted position
+    pos = [0] * cnt
+    for new, old in enumerate(order):
+        pos[old] = new
+        elf.data[base + new * size:base + (new + 1) * size] = recs[old][3]
+
+    def move(addr):
+        idx, ofs = divmod(addr - start, size)
+        return start + pos[idx] * size + ofs
+
+    for _, value, st_size, st_type, ofs in syms:
+        if (STT_OBJECT == st_type) and st_size and (start <= value < stop):
+            elf.set_symbol(ofs, move(value))
+
+    for ofs, addr in elf.relocations():
+        if start <= addr < stop:
+            elf.set_relocation(ofs, move(addr))
+
+    elf.write(path)
+
+    return 0
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.stderr.write("Usage: %s ELF\n" % sys.argv[0])
+        return 1
+
+    return tbl_sort(sys.argv[1])
+
+
+if __name__ == "__main__":
+    sys.exit(main())
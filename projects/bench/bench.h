@@ -0,0 +1,54 @@
+/**
+ * @brief PINKIE - Benchmarks
+ *
+ * Copyright (c) 2017, Sven Bachmann <dev@mcbachmann.de>
+ *
+ * Licensed under the MIT license, see LICENSE for details.
+ */
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <pinkie.h>
+
+
+/*****************************************************************************/
+/* Prototypes */
+/*****************************************************************************/
+uint64_t bench_ns(
+    void
+);
+
+uint32_t bench_rand(
+    void
+);
+
+void bench_fmt(
+    void
+);
+
+void bench_i2s(
+    void
+);
+
+void bench_regreg(
+    void
+);
+
+void bench_regreg_ctx(
+    void
+);
+
+void bench_regreg_mt(
+    void
+);
+
+void bench_regreg_sparse(
+    void
+);
+
+void bench_ring(
+    void
+);
+
+
+#endif /* BENCH_H */
@@ -0,0 +1,296 @@
+/**
+ * @brief PINKIE - Precompiled Format Benchmark
+ *
+ * Measures the time per formatted line for the register read output and a
+ * three byte announcement, once parsed by pinkie_vprintf_sink and once with
+ * the precompiled format of pinkie_vprintf_fmt_sink. Output goes to a
+ * truncating buffer sink, so only the formatting is measured. Both outputs
+ * are compared before measuring.
+ *
+ * On x86 the time stamp counter is read additionally to report cycles.
+ *
+ * Copyright (c) 2017, Sven Bachmann <dev@mcbachmann.de>
+ *
+ * Licensed under the MIT license, see LICENSE for details.
+ */
+#include <regreg.h>
+#include "bench.h"
+
+
+/*****************************************************************************/
+/* Local defines */
+/*****************************************************************************/
+#define BENCH_FMT_VALS                  1024    /**< random values */
+#define BENCH_FMT_CALLS                 1000000 /**< lines per run */
+#define BENCH_FMT_BUF_LEN               64      /**< line buffer size */
+
+#if defined(__x86_64__) || defined(__i386__)
+#  define BENCH_FMT_CYCLES()            __builtin_ia32_rdtsc()
+#else
+#  define BENCH_FMT_CYCLES()            0
+#endif
+
+
+/*****************************************************************************/
+/* Local datatypes */
+/*****************************************************************************/
+typedef struct {
+    uint64_t ns;                                /**< elapsed time */
+    uint64_t cycles;                            /**< elapsed cycles */
+} BENCH_FMT_RES_T;
+
+typedef void (*BENCH_FMT_FUNC_T)(
+    PINKIE_SINK_T *sink,                        /**< sink */
+    REG_ADDR_T addr,                            /**< register address */
+    uint32_t val                                /**< random value */
+);
+
+typedef struct {
+    const char *name;                           /**< case name */
+    BENCH_FMT_FUNC_T func_parse;                /**< parsed format */
+    BENCH_FMT_FUNC_T func_ops;                  /**< precompiled format */
+} BENCH_FMT_CASE_T;
+
+
+/*****************************************************************************/
+/* Local prototypes */
+/*****************************************************************************/
+static void bench_fmt_parse(
+    PINKIE_SINK_T *sink,                        /**< sink */
+    const char *fmt,                            /**< format string */
+    ...                                         /**< variable arguments */
+) __attribute__((format(printf, 2, 3)));
+
+static void bench_fmt_ops(
+    PINKIE_SINK_T *sink,                        /**< sink */
+    const PINKIE_FMT_OP_T *op,                  /**< precompiled format */
+    ...                                         /**< variable arguments */
+);
+
+static void bench_fmt_read16_parse(
+    PINKIE_SINK_T *sink,                        /**< sink */
+    REG_ADDR_T addr,                            /**< register address */
+    uint32_t val                                /**< random value */
+);
+
+static void bench_fmt_read16_ops(
+    PINKIE_SINK_T *sink,                        /**< sink */
+    REG_ADDR_T addr,                            /**< register address */
+    uint32_t val                                /**< random value */
+);
+
+static void bench_fmt_ann_parse(
+    PINKIE_SINK_T *sink,                        /**< sink */
+    REG_ADDR_T addr,                            /**< register address */
+    uint32_t val                                /**< random value */
+);
+
+static void bench_fmt_ann_ops(
+    PINKIE_SINK_T *sink,                        /**< sink */
+    REG_ADDR_T addr,                            /**< register address */
+    uint32_t val                                /**< random value */
+);
+
+static void bench_fmt_run(
+    BENCH_FMT_FUNC_T func,                      /**< format function */
+    BENCH_FMT_RES_T *res                        /**< result */
+);
+
+
+/*****************************************************************************/
+/* Local variables */
+/*****************************************************************************/
+static uint32_t bench_vals[BENCH_FMT_VALS];     /**< random values */
+
+static const PINKIE_FMT_OP_T bench_fmt_read16[] = { /**< "%u: 0x%04x (u: %u, i: %i)\n" */
+    PINKIE_FMT_U(REG_ADDR_T), PINKIE_FMT_TEXT(": 0x"), PINKIE_FMT_X0(uint16_t, 4),
+    PINKIE_FMT_TEXT(" (u: "), PINKIE_FMT_U(uint16_t), PINKIE_FMT_TEXT(", i: "), PINKIE_FMT_I(int16_t),
+    PINKIE_FMT_TEXT(")\n"), PINKIE_FMT_END
+};
+
+static const PINKIE_FMT_OP_T bench_fmt_ann[] = { /**< "ann %u:" */
+    PINKIE_FMT_TEXT("ann "), PINKIE_FMT_U(REG_ADDR_T), PINKIE_FMT_TEXT(":"), PINKIE_FMT_END
+};
+
+static const PINKIE_FMT_OP_T bench_fmt_ann_byte[] = { /**< " 0x%02x" */
+    PINKIE_FMT_TEXT(" 0x"), PINKIE_FMT_X0(uint8_t, 2), PINKIE_FMT_END
+};
+
+static const PINKIE_FMT_OP_T bench_fmt_ann_end[] = { /**< "\n" */
+    PINKIE_FMT_TEXT("\n"), PINKIE_FMT_END
+};
+
+static const BENCH_FMT_CASE_T bench_cases[] = { /**< benchmark cases */
+    { "read16", bench_fmt_read16_parse, bench_fmt_read16_ops },
+    { "ann", bench_fmt_ann_parse, bench_fmt_ann_ops },
+};
+
+
+/*****************************************************************************/
+/** Parse format to sink
+ */
+static void bench_fmt_parse(
+    PINKIE_SINK_T *sink,                        /**< sink */
+    const char *fmt,                            /**< format string */
+    ...                                         /**< variable arguments */
+)
+{
+    va_list ap;                                 /* variable argument list */
+
+    va_start(ap, fmt);
+    pinkie_vprintf_sink(sink, fmt, ap);
+    va_end(ap);
+}
+
+
+/*****************************************************************************/
+/** Run precompiled format to sink
+ */
+static void bench_fmt_ops(
+    PINKIE_SINK_T *sink,                        /**< sink */
+    const PINKIE_FMT_OP_T *op,                  /**< precompiled format */
+    ...                                         /**< variable arguments */
+)
+{
+    va_list ap;                                 /* variable argument list */
+
+    va_start(ap, op);
+    pinkie_vprintf_fmt_sink(sink, op, ap);
+    va_end(ap);
+}
+
+
+/*****************************************************************************/
+/** 16-bit register read line, parsed
+ */
+static void bench_fmt_read16_parse(
+    PINKIE_SINK_T *sink,                        /**< sink */
+    REG_ADDR_T addr,                            /**< register address */
+    uint32_t val                                /**< random value */
+)
+{
+    bench_fmt_parse(sink, "%" PRIuREG ": 0x%04" PRIx16 " (u: %" PRIu16 ", i: %" PRIi16 ")\n",
+                    addr, (uint16_t) val, (uint16_t) val, (int16_t) val);
+}
+
+
+/*****************************************************************************/
+/** 16-bit register read line, precompiled
+ */
+static void bench_fmt_read16_ops(
+    PINKIE_SINK_T *sink,                        /**< sink */
+    REG_ADDR_T addr,                            /**< register address */
+    uint32_t val                                /**< random value */
+)
+{
+    bench_fmt_ops(sink, bench_fmt_read16, addr, (uint16_t) val, (uint16_t) val, (int16_t) val);
+}
+
+
+/*****************************************************************************/
+/** Three byte announcement, parsed
+ */
+static void bench_fmt_ann_parse(
+    PINKIE_SINK_T *sink,                        /**< sink */
+    REG_ADDR_T addr,                            /**< register address */
+    uint32_t val                                /**< random value */
+)
+{
+    bench_fmt_parse(sink, "ann %" PRIuREG ":", addr);
+    bench_fmt_parse(sink, " 0x%02x", (uint8_t) val);
+    bench_fmt_parse(sink, " 0x%02x", (uint8_t) (val >> 8));
+    bench_fmt_parse(sink, " 0x%02x", (uint8_t) (val >> 16));
+    bench_fmt_parse(sink, "\n");
+}
+
+
+/*****************************************************************************/
+/** Three byte announcement, precompiled
+ */
+static void bench_fmt_ann_ops(
+    PINKIE_SINK_T *sink,                        /**< sink */
+    REG_ADDR_T addr,                            /**< register address */
+    uint32_t val                                /**< random value */
+)
+{
+    bench_fmt_ops(sink, bench_fmt_ann, addr);
+    bench_fmt_ops(sink, bench_fmt_ann_byte, (uint8_t) val);
+    bench_fmt_ops(sink, bench_fmt_ann_byte, (uint8_t) (val >> 8));
+    bench_fmt_ops(sink, bench_fmt_ann_byte, (uint8_t) (val >> 16));
+    bench_fmt_ops(sink, bench_fmt_ann_end);
+}
+
+
+/*****************************************************************************/
+/** Format all values repeatedly
+ */
+static void bench_fmt_run(
+    BENCH_FMT_FUNC_T func,                      /**< format function */
+    BENCH_FMT_RES_T *res                        /**< result */
+)
+{
+    unsigned int cnt;                           /* counter */
+    uint64_t ts;                                /* timestamp */
+    uint64_t cycles;                            /* cycle counter */
+    char buf[BENCH_FMT_BUF_LEN];                /* line buffer */
+    PINKIE_SINK_BUF_T sbuf;                     /* buffer sink */
+
+    ts = bench_ns();
+    cycles = BENCH_FMT_CYCLES();
+    for (cnt = 0; cnt < BENCH_FMT_CALLS; cnt++) {
+        pinkie_sink_buf_init(&sbuf, buf, sizeof(buf), NULL);
+        func(&sbuf.sink, (REG_ADDR_T) cnt, bench_vals[cnt % BENCH_FMT_VALS]);
+    }
+    res->cycles = BENCH_FMT_CYCLES() - cycles;
+    res->ns = bench_ns() - ts;
+}
+
+
+/*****************************************************************************/
+/** Precompiled format benchmark
+ */
+void bench_fmt(
+    void
+)
+{
+    unsigned int idx;                           /* case index */
+    unsigned int cnt;                           /* counter */
+    char buf_parse[BENCH_FMT_BUF_LEN];          /* parsed output */
+    char buf_ops[BENCH_FMT_BUF_LEN];            /* precompiled output */
+    PINKIE_SINK_BUF_T sbuf_parse;               /* parsed sink */
+    PINKIE_SINK_BUF_T sbuf_ops;                 /* precompiled sink */
+    BENCH_FMT_RES_T res_parse;                  /* parsed result */
+    BENCH_FMT_RES_T res_ops;                    /* precompiled result */
+
+    for (cnt = 0; cnt < BENCH_FMT_VALS; cnt++) {
+        bench_vals[cnt] = bench_rand();
+    }
+
+    for (idx = 0; idx < PINKIE_ARRAY_COUNT(bench_cases); idx++) {
+
+        /* both variants must produce the same output */
+        for (cnt = 0; cnt < BENCH_FMT_VALS; cnt++) {
+            pinkie_sink_buf_init(&sbuf_parse, buf_parse, sizeof(buf_parse), NULL);
+            pinkie_sink_buf_init(&sbuf_ops, buf_ops, sizeof(buf_ops), NULL);
+            bench_cases[idx].func_parse(&sbuf_parse.sink, (REG_ADDR_T) bench_vals[cnt], bench_vals[cnt]);
+            bench_cases[idx].func_ops(&sbuf_ops.sink, (REG_ADDR_T) bench_vals[cnt], bench_vals[cnt]);
+
+            if ((sbuf_parse.cnt != sbuf_ops.cnt) || (memcmp(buf_parse, buf_ops, sbuf_parse.pos))) {
+                pinkie_printf("  %s: output mismatch for 0x%x\n", bench_cases[idx].name, bench_vals[cnt]);
+                return;
+            }
+        }
+
+        bench_fmt_run(bench_cases[idx].func_ops, &res_ops);
+        bench_fmt_run(bench_cases[idx].func_parse, &res_parse);
+
+        pinkie_printf("  %s: %3u.%u ns/line, %4u cycles/line (parsed: %4u.%u ns/line, %5u cycles/line)\n",
+                      bench_cases[idx].name,
+                      (unsigned int) (res_ops.ns / BENCH_FMT_CALLS),
+                      (unsigned int) (((res_ops.ns * 10) / BENCH_FMT_CALLS) % 10),
+                      (unsigned int) (res_ops.cycles / BENCH_FMT_CALLS),
+                      (unsigned int) (res_parse.ns / BENCH_FMT_CALLS),
+                      (unsigned int) (((res_parse.ns * 10) / BENCH_FMT_CALLS) % 10),
+                      (unsigned int) (res_parse.cycles / BENCH_FMT_CALLS));
+    }
+}
@@ -0,0 +1,183 @@
+/**
+ * @brief PINKIE - Integer To String Benchmark
+ *
+ * Measures the time per pinkie_i2s() call for random 8, 16, 32 and 64 bit
+ * values in base 10 and 16. The former digit-by-digit conversion, which
+ * re-divides the number for every digit, is measured as reference. Output
+ * is discarded to /dev/null while measuring.
+ *
+ * On x86 the time stamp counter is read additionally to report cycles.
+ *
+ * Copyright (c) 2017, Sven Bachmann <dev@mcbachmann.de>
+ *
+ * Licensed under the MIT license, see LICENSE for details.
+ */
+#define _POSIX_C_SOURCE 200112L
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+#include "bench.h"
+
+
+/*****************************************************************************/
+/* Local defines */
+/*****************************************************************************/
+#define BENCH_I2S_VALS                  1024    /**< random values per width */
+#define BENCH_I2S_CALLS                 1000000 /**< conversions per run */
+
+#if defined(__x86_64__) || defined(__i386__)
+#  define BENCH_I2S_CYCLES()            __builtin_ia32_rdtsc()
+#else
+#  define BENCH_I2S_CYCLES()            0
+#endif
+
+
+/*****************************************************************************/
+/* Local datatypes */
+/*****************************************************************************/
+typedef struct {
+    uint64_t ns;                                /**< elapsed time */
+    uint64_t cycles;                            /**< elapsed cycles */
+} BENCH_I2S_RES_T;
+
+
+/*****************************************************************************/
+/* Local variables */
+/*****************************************************************************/
+static PINKIE_PRINTF_UINT_T bench_vals[BENCH_I2S_VALS]; /**< values */
+static const unsigned int bench_widths[] = { 1, 2, 4, 8 }; /**< value widths */
+
+
+/*****************************************************************************/
+/* Local prototypes */
+/*****************************************************************************/
+static void bench_i2s_ref(
+    PINKIE_PRINTF_UINT_T num,                   /**< unsigned integer */
+    unsigned int base,                          /**< base */
+    uint8_t flg_zero,                           /**< prefix with zero */
+    uint8_t cnt_pad                             /**< pad count */
+);
+
+static void bench_i2s_run(
+    void (*func)(PINKIE_PRINTF_UINT_T, unsigned int, uint8_t, uint8_t), /**< converter */
+    unsigned int base,                          /**< base */
+    BENCH_I2S_RES_T *res                        /**< result */
+);
+
+
+/*****************************************************************************/
+/** Digit-by-digit conversion reference
+ */
+static void bench_i2s_ref(
+    PINKIE_PRINTF_UINT_T num,                   /**< unsigned integer */
+    unsigned int base,                          /**< base */
+    uint8_t flg_zero,                           /**< prefix with zero */
+    uint8_t cnt_pad                             /**< pad count */
+)
+{
+    PINKIE_PRINTF_UINT_T num_temp;              /* temporary number buffer */
+    unsigned int digit = 0;                     /* found digit */
+    unsigned int digits = 0;                    /* digits found */
+    unsigned int digit_cnt;                     /* digit counter */
+    uint8_t pad;                                /* pad character */
+
+    for (num_temp = num; num_temp; digit = num_temp % base, num_temp /= base, digits++);
+
+    if (cnt_pad > digits) {
+        pad = ((flg_zero) || (!digits)) ? '0' : ' ';
+        for (cnt_pad -= digits; cnt_pad; cnt_pad--) {
+            pinkie_stdio_putc(pad);
+        }
+    }
+
+    for (; digits; digits--) {
+        for (num_temp = num, digit_cnt = digits; digit_cnt; digit_cnt--, digit = num_temp % base, num_temp /= base);
+
+        pinkie_stdio_putc(digit + ((digit < 10) ? '0' : ('a' - 10)));
+    }
+}
+
+
+/*****************************************************************************/
+/** Convert all values repeatedly
+ */
+static void bench_i2s_run(
+    void (*func)(PINKIE_PRINTF_UINT_T, unsigned int, uint8_t, uint8_t), /**< converter */
+    unsigned int base,                          /**< base */
+    BENCH_I2S_RES_T *res                        /**< result */
+)
+{
+    unsigned int cnt;                           /* counter */
+    uint64_t ts;                                /* timestamp */
+    uint64_t cycles;                            /* cycle counter */
+
+    ts = bench_ns();
+    cycles = BENCH_I2S_CYCLES();
+    for (cnt = 0; cnt < BENCH_I2S_CALLS; cnt++) {
+        func(bench_vals[cnt % BENCH_I2S_VALS], base, 0, 1);
+    }
+    res->cycles = BENCH_I2S_CYCLES() - cycles;
+    res->ns = bench_ns() - ts;
+}
+
+
+/*****************************************************************************/
+/** Integer to string benchmark
+ */
+void bench_i2s(
+    void
+)
+{
+    unsigned int idx;                           /* width index */
+    unsigned int base;                          /* base */
+    unsigned int cnt;                           /* counter */
+    int fd_out;                                 /* saved stdout */
+    int fd_null;                                /* null device */
+    uint64_t val;                               /* random value */
+    BENCH_I2S_RES_T res_new;                    /* pinkie_i2s result */
+    BENCH_I2S_RES_T res_ref;                    /* reference result */
+
+    fd_null = open("/dev/null", O_WRONLY);
+    if (0 > fd_null) {
+        pinkie_printf("couldn't open /dev/null\n");
+        return;
+    }
+
+    for (idx = 0; idx < PINKIE_ARRAY_COUNT(bench_widths); idx++) {
+
+        if (PINKIE_CFG_PRINTF_MAX_INT < bench_widths[idx]) {
+            break;
+        }
+
+        for (cnt = 0; cnt < BENCH_I2S_VALS; cnt++) {
+            val = ((uint64_t) bench_rand() << 32) | bench_rand();
+            bench_vals[cnt] = (PINKIE_PRINTF_UINT_T) (val >> (64 - (bench_widths[idx] * 8)));
+        }
+
+        for (base = 10; base <= 16; base += 6) {
+
+            /* discard output while measuring */
+            fflush(stdout);
+            fd_out = dup(STDOUT_FILENO);
+            dup2(fd_null, STDOUT_FILENO);
+
+            bench_i2s_run(pinkie_i2s, base, &res_new);
+            bench_i2s_run(bench_i2s_ref, base, &res_ref);
+
+            fflush(stdout);
+            dup2(fd_out, STDOUT_FILENO);
+            close(fd_out);
+
+            pinkie_printf("  %2u bit, base %2u: %3u.%u ns/call, %4u cycles/call (reference: %4u.%u ns/call, %5u cycles/call)\n",
+                          bench_widths[idx] * 8, base,
+                          (unsigned int) (res_new.ns / BENCH_I2S_CALLS),
+                          (unsigned int) (((res_new.ns * 10) / BENCH_I2S_CALLS) % 10),
+                          (unsigned int) (res_new.cycles / BENCH_I2S_CALLS),
+                          (unsigned int) (res_ref.ns / BENCH_I2S_CALLS),
+                          (unsigned int) (((res_ref.ns * 10) / BENCH_I2S_CALLS) % 10),
+                          (unsigned int) (res_ref.cycles / BENCH_I2S_CALLS));
+        }
+    }
+
+    close(fd_null);
+}
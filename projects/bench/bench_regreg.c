@@ -0,0 +1,121 @@
+/**
+ * @brief PINKIE - RegReg Lookup Benchmark
+ *
+ * Measures the time per register lookup through reg_rw() for a growing
+ * count of register entries. A plain linear scan over the same entries is
+ * measured as reference.
+ *
+ * Copyright (c) 2017, Sven Bachmann <dev@mcbachmann.de>
+ *
+ * Licensed under the MIT license, see LICENSE for details.
+ */
+#include <regreg.h>
+#include "bench.h"
+
+
+/*****************************************************************************/
+/* Local defines */
+/*****************************************************************************/
+#define BENCH_REGREG_WIDTH              4       /**< addresses per entry */
+#define BENCH_REGREG_LOOKUPS            1000000 /**< lookups per run */
+
+
+/*****************************************************************************/
+/* Local variables */
+/*****************************************************************************/
+static REG_ENTRY_T bench_regs[PINKIE_CFG_REGREG_ENTRIES]; /**< register entries */
+static uint8_t bench_data[BENCH_REGREG_WIDTH];  /**< shared register data */
+static const unsigned int bench_cnts[] = { 10, 100, 10000 }; /**< entry counts */
+
+
+/*****************************************************************************/
+/* Local prototypes */
+/*****************************************************************************/
+static REG_ENTRY_T * bench_regreg_linear(
+    unsigned int cnt,                           /**< entry count */
+    REG_ADDR_T addr                             /**< register address */
+);
+
+
+/*****************************************************************************/
+/** Linear lookup reference
+ */
+static REG_ENTRY_T * bench_regreg_linear(
+    unsigned int cnt,                           /**< entry count */
+    REG_ADDR_T addr                             /**< register address */
+)
+{
+    unsigned int pos;                           /* position */
+
+    for (pos = 0; pos < cnt; pos++) {
+        if ((addr >= bench_regs[pos].addr_beg) && (addr <= bench_regs[pos].addr_end)) {
+            return &bench_regs[pos];
+        }
+    }
+
+    return NULL;
+}
+
+
+/*****************************************************************************/
+/** RegReg lookup benchmark
+ */
+void bench_regreg(
+    void
+)
+{
+    unsigned int cnt_regs = 0;                  /* registered entries */
+    unsigned int idx;                           /* entry count index */
+    unsigned int cnt;                           /* counter */
+    uint64_t ts;                                /* timestamp */
+    uint64_t ns_add;                            /* registration time */
+    uint64_t ns_idx;                            /* indexed lookup time */
+    uint64_t ns_lin;                            /* linear lookup time */
+    uint8_t val;                                /* read value */
+    volatile uintptr_t sink = 0;                /* result sink */
+    REG_ACC_T reg_acc;                          /* register access */
+
+    reg_acc.write_flg = 0;
+    reg_acc.data.write_to = &val;
+
+    for (idx = 0; idx < PINKIE_ARRAY_COUNT(bench_cnts); idx++) {
+
+        /* grow register map up to the wanted entry count */
+        ts = bench_ns();
+        for (; cnt_regs < bench_cnts[idx]; cnt_regs++) {
+            bench_regs[cnt_regs].addr_beg = cnt_regs * BENCH_REGREG_WIDTH;
+            bench_regs[cnt_regs].addr_end = (cnt_regs * BENCH_REGREG_WIDTH) + BENCH_REGREG_WIDTH - 1;
+            bench_regs[cnt_regs].data = bench_data;
+
+            if (reg_add(&bench_regs[cnt_regs])) {
+                pinkie_printf("reg_add failed at entry %u\n", cnt_regs);
+                return;
+            }
+        }
+        ns_add = bench_ns() - ts;
+
+        /* indexed lookup through reg_rw */
+        ts = bench_ns();
+        for (cnt = 0; cnt < BENCH_REGREG_LOOKUPS; cnt++) {
+            reg_acc.addr = bench_rand() % (cnt_regs * BENCH_REGREG_WIDTH);
+            reg_acc.data_len = 1;
+            sink += reg_rw(&reg_acc);
+        }
+        ns_idx = bench_ns() - ts;
+
+        /* linear reference */
+        ts = bench_ns();
+        for (cnt = 0; cnt < BENCH_REGREG_LOOKUPS; cnt++) {
+            sink += (uintptr_t) bench_regreg_linear(cnt_regs, bench_rand() % (cnt_regs * BENCH_REGREG_WIDTH));
+        }
+        ns_lin = bench_ns() - ts;
+
+        pinkie_printf("  %5u entries: %3u.%u ns/lookup (linear: %u.%u ns/lookup, total add: %u us)\n",
+                      cnt_regs,
+                      (unsigned int) (ns_idx / BENCH_REGREG_LOOKUPS),
+                      (unsigned int) (((ns_idx * 10) / BENCH_REGREG_LOOKUPS) % 10),
+                      (unsigned int) (ns_lin / BENCH_REGREG_LOOKUPS),
+                      (unsigned int) (((ns_lin * 10) / BENCH_REGREG_LOOKUPS) % 10),
+                      (unsigned int) (ns_add / 1000));
+    }
+}
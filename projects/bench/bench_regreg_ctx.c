@@ -0,0 +1,88 @@
+/**
+ * @brief PINKIE - RegReg Context Benchmark
+ *
+ * Creates many independent register contexts - one per simulated device - and
+ * measures the time per register access through reg_ctx_rw() on randomly
+ * selected contexts.
+ *
+ * Copyright (c) 2017, Sven Bachmann <dev@mcbachmann.de>
+ *
+ * Licensed under the MIT license, see LICENSE for details.
+ */
+#include <regreg.h>
+#include "bench.h"
+
+
+/*****************************************************************************/
+/* Local defines */
+/*****************************************************************************/
+#define BENCH_CTX_CNT                   4096    /**< register contexts */
+#define BENCH_CTX_REGS                  16      /**< entries per context */
+#define BENCH_CTX_WIDTH                 4       /**< addresses per entry */
+#define BENCH_CTX_LOOKUPS               1000000 /**< lookups per run */
+
+
+/*****************************************************************************/
+/* Local variables */
+/*****************************************************************************/
+static REGREG_CTX_T bench_ctxs[BENCH_CTX_CNT];  /**< register contexts */
+static REG_ENTRY_T *bench_idx[BENCH_CTX_CNT][BENCH_CTX_REGS]; /**< index storage */
+static REG_ENTRY_T bench_regs[BENCH_CTX_CNT][BENCH_CTX_REGS]; /**< register entries */
+static uint8_t bench_data[BENCH_CTX_CNT][BENCH_CTX_WIDTH]; /**< register data */
+
+
+/*****************************************************************************/
+/** RegReg context benchmark
+ */
+void bench_regreg_ctx(
+    void
+)
+{
+    unsigned int ctx;                           /* context counter */
+    unsigned int pos;                           /* entry counter */
+    unsigned int cnt;                           /* counter */
+    uint64_t ts;                                /* timestamp */
+    uint64_t ns_add;                            /* setup time */
+    uint64_t ns_rw;                             /* access time */
+    uint8_t val;                                /* read value */
+    volatile unsigned int sink = 0;             /* result sink */
+    REG_ACC_T reg_acc;                          /* register access */
+
+    /* create contexts with their own register entries */
+    ts = bench_ns();
+    for (ctx = 0; ctx < BENCH_CTX_CNT; ctx++) {
+        reg_ctx_init(&bench_ctxs[ctx], bench_idx[ctx], BENCH_CTX_REGS, NULL, NULL);
+
+        for (pos = 0; pos < BENCH_CTX_REGS; pos++) {
+            bench_regs[ctx][pos].addr_beg = pos * BENCH_CTX_WIDTH;
+            bench_regs[ctx][pos].addr_end = (pos * BENCH_CTX_WIDTH) + BENCH_CTX_WIDTH - 1;
+            bench_regs[ctx][pos].data = bench_data[ctx];
+
+            if (reg_ctx_add(&bench_ctxs[ctx], &bench_regs[ctx][pos])) {
+                pinkie_printf("reg_ctx_add failed at context %u, entry %u\n", ctx, pos);
+                return;
+            }
+        }
+    }
+    ns_add = bench_ns() - ts;
+
+    /* access random registers in random contexts */
+    reg_acc.write_flg = 0;
+    reg_acc.data.write_to = &val;
+
+    ts = bench_ns();
+    for (cnt = 0; cnt < BENCH_CTX_LOOKUPS; cnt++) {
+        reg_acc.addr = bench_rand() % (BENCH_CTX_REGS * BENCH_CTX_WIDTH);
+        reg_acc.data_len = 1;
+        sink += reg_ctx_rw(&bench_ctxs[bench_rand() % BENCH_CTX_CNT], &reg_acc);
+    }
+    ns_rw = bench_ns() - ts;
+
+    pinkie_printf("  %u contexts x %u entries: %u.%u ns/access (setup: %u us, %u bytes/context)\n",
+                  BENCH_CTX_CNT,
+                  BENCH_CTX_REGS,
+                  (unsigned int) (ns_rw / BENCH_CTX_LOOKUPS),
+                  (unsigned int) (((ns_rw * 10) / BENCH_CTX_LOOKUPS) % 10),
+                  (unsigned int) (ns_add / 1000),
+                  (unsigned int) (sizeof(REGREG_CTX_T) + sizeof(bench_idx[0])));
+}
@@ -0,0 +1,120 @@
+/**
+ * @brief PINKIE - RegReg Multi-Thread Benchmark
+ *
+ * Measures the total reg_rw() throughput of a growing count of reader
+ * threads. Lookups are lock-free, so the throughput should scale with the
+ * available cores as long as the threads access different entries.
+ *
+ * Copyright (c) 2017, Sven Bachmann <dev@mcbachmann.de>
+ *
+ * Licensed under the MIT license, see LICENSE for details.
+ */
+#include <pthread.h>
+#include <regreg.h>
+#include "bench.h"
+
+
+/*****************************************************************************/
+/* Local defines */
+/*****************************************************************************/
+#define BENCH_MT_REGS                   1024    /**< register entries */
+#define BENCH_MT_WIDTH                  4       /**< addresses per entry */
+#define BENCH_MT_LOOKUPS                1000000 /**< lookups per thread */
+#define BENCH_MT_THREADS_MAX            8       /**< max thread count */
+
+
+/*****************************************************************************/
+/* Local variables */
+/*****************************************************************************/
+static REGREG_CTX_T bench_ctx;                  /**< register context */
+static REG_ENTRY_T *bench_idx[BENCH_MT_REGS];   /**< index storage */
+static REG_ENTRY_T bench_regs[BENCH_MT_REGS];   /**< register entries */
+static uint8_t bench_data[BENCH_MT_REGS][BENCH_MT_WIDTH]; /**< register data */
+
+
+/*****************************************************************************/
+/* Local prototypes */
+/*****************************************************************************/
+static void * bench_regreg_mt_thread(
+    void *arg                                   /**< thread seed */
+);
+
+
+/*****************************************************************************/
+/** Reader thread
+ */
+static void * bench_regreg_mt_thread(
+    void *arg                                   /**< thread seed */
+)
+{
+    uint32_t seed = (uint32_t) (uintptr_t) arg; /* random seed */
+    unsigned int cnt;                           /* counter */
+    uint8_t val;                                /* read value */
+    uintptr_t sink = 0;                         /* result sink */
+    REG_ACC_T reg_acc;                          /* register access */
+
+    reg_acc.write_flg = 0;
+    reg_acc.data.write_to = &val;
+
+    for (cnt = 0; cnt < BENCH_MT_LOOKUPS; cnt++) {
+
+        /* thread local xorshift32, bench_rand() isn't thread-safe */
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+
+        reg_acc.addr = seed % (BENCH_MT_REGS * BENCH_MT_WIDTH);
+        reg_acc.data_len = 1;
+        sink += reg_ctx_rw(&bench_ctx, &reg_acc);
+    }
+
+    return (void *) sink;
+}
+
+
+/*****************************************************************************/
+/** RegReg multi-thread benchmark
+ */
+void bench_regreg_mt(
+    void
+)
+{
+    unsigned int pos;                           /* entry counter */
+    unsigned int cnt_threads;                   /* thread count */
+    unsigned int cnt;                           /* counter */
+    uint64_t ts;                                /* timestamp */
+    uint64_t ns;                                /* run time */
+    pthread_t threads[BENCH_MT_THREADS_MAX];    /* threads */
+
+    reg_ctx_init(&bench_ctx, bench_idx, BENCH_MT_REGS, NULL, NULL);
+    for (pos = 0; pos < BENCH_MT_REGS; pos++) {
+        bench_regs[pos].addr_beg = pos * BENCH_MT_WIDTH;
+        bench_regs[pos].addr_end = (pos * BENCH_MT_WIDTH) + BENCH_MT_WIDTH - 1;
+        bench_regs[pos].data = bench_data[pos];
+
+        if (reg_ctx_add(&bench_ctx, &bench_regs[pos])) {
+            pinkie_printf("reg_ctx_add failed at entry %u\n", pos);
+            return;
+        }
+    }
+
+    for (cnt_threads = 1; cnt_threads <= BENCH_MT_THREADS_MAX; cnt_threads <<= 1) {
+
+        ts = bench_ns();
+        for (cnt = 0; cnt < cnt_threads; cnt++) {
+            if (pthread_create(&threads[cnt], NULL, bench_regreg_mt_thread, (void *) (uintptr_t) (cnt + 1))) {
+                pinkie_printf("pthread_create failed\n");
+                return;
+            }
+        }
+
+        for (cnt = 0; cnt < cnt_threads; cnt++) {
+            pthread_join(threads[cnt], NULL);
+        }
+        ns = bench_ns() - ts;
+
+        pinkie_printf("  %u threads: %u k accesses/s\n",
+                      cnt_threads,
+                      (unsigned int) (((uint64_t) cnt_threads * BENCH_MT_LOOKUPS * 1000000ULL) / ns));
+    }
+}
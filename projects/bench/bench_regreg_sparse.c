@@ -0,0 +1,130 @@
+/**
+ * @brief PINKIE - RegReg Sparse Address Benchmark
+ *
+ * Measures the lookup time for registers spread over the 32-bit address
+ * space compared to the same count of densely packed registers. With the
+ * page table both should stay in the same range.
+ *
+ * Copyright (c) 2017, Sven Bachmann <dev@mcbachmann.de>
+ *
+ * Licensed under the MIT license, see LICENSE for details.
+ */
+#include <regreg.h>
+#include "bench.h"
+
+#if PINKIE_CFG_REGREG_ADDR32 == 1
+
+
+/*****************************************************************************/
+/* Local defines */
+/*****************************************************************************/
+#define BENCH_SPARSE_REGS               10000   /**< max register entries */
+#define BENCH_SPARSE_WIDTH              4       /**< addresses per entry */
+#define BENCH_SPARSE_BLOCKS             4       /**< used 1G address blocks */
+#define BENCH_SPARSE_STRIDE             0x1000  /**< entry distance in a block */
+#define BENCH_SPARSE_LOOKUPS            1000000 /**< lookups per run */
+
+
+/*****************************************************************************/
+/* Local variables */
+/*****************************************************************************/
+static REGREG_CTX_T bench_ctx_dense;            /**< dense register context */
+static REGREG_CTX_T bench_ctx_sparse;           /**< sparse register context */
+static REG_ENTRY_T *bench_idx_dense[BENCH_SPARSE_REGS]; /**< dense index storage */
+static REG_ENTRY_T *bench_idx_sparse[BENCH_SPARSE_REGS]; /**< sparse index storage */
+static REG_ENTRY_T bench_regs_dense[BENCH_SPARSE_REGS]; /**< dense register entries */
+static REG_ENTRY_T bench_regs_sparse[BENCH_SPARSE_REGS]; /**< sparse register entries */
+static uint8_t bench_data[BENCH_SPARSE_WIDTH];  /**< shared register data */
+static const unsigned int bench_cnts[] = { 10, 100, 10000 }; /**< entry counts */
+
+
+/*****************************************************************************/
+/* Local prototypes */
+/*****************************************************************************/
+static uint64_t bench_regreg_sparse_run(
+    REGREG_CTX_T *ctx,                          /**< register context */
+    REG_ENTRY_T *regs,                          /**< register entries */
+    unsigned int cnt_regs                       /**< register count */
+);
+
+
+/*****************************************************************************/
+/** Random lookups in a context
+ *
+ * @returns run time in ns
+ */
+static uint64_t bench_regreg_sparse_run(
+    REGREG_CTX_T *ctx,                          /**< register context */
+    REG_ENTRY_T *regs,                          /**< register entries */
+    unsigned int cnt_regs                       /**< register count */
+)
+{
+    unsigned int cnt;                           /* counter */
+    uint64_t ts;                                /* timestamp */
+    uint8_t val;                                /* read value */
+    volatile uintptr_t sink = 0;                /* result sink */
+    REG_ACC_T reg_acc;                          /* register access */
+
+    reg_acc.write_flg = 0;
+    reg_acc.data.write_to = &val;
+
+    ts = bench_ns();
+    for (cnt = 0; cnt < BENCH_SPARSE_LOOKUPS; cnt++) {
+        reg_acc.addr = regs[bench_rand() % cnt_regs].addr_beg + (bench_rand() % BENCH_SPARSE_WIDTH);
+        reg_acc.data_len = 1;
+        sink += reg_ctx_rw(ctx, &reg_acc);
+    }
+
+    return bench_ns() - ts;
+}
+
+
+/*****************************************************************************/
+/** RegReg sparse address benchmark
+ */
+void bench_regreg_sparse(
+    void
+)
+{
+    unsigned int cnt_regs = 0;                  /* registered entries */
+    unsigned int idx;                           /* entry count index */
+    uint64_t ns_dense;                          /* dense lookup time */
+    uint64_t ns_sparse;                         /* sparse lookup time */
+
+    reg_ctx_init(&bench_ctx_dense, bench_idx_dense, BENCH_SPARSE_REGS, NULL, NULL);
+    reg_ctx_init(&bench_ctx_sparse, bench_idx_sparse, BENCH_SPARSE_REGS, NULL, NULL);
+
+    for (idx = 0; idx < PINKIE_ARRAY_COUNT(bench_cnts); idx++) {
+
+        /* grow both register maps up to the wanted entry count */
+        for (; cnt_regs < bench_cnts[idx]; cnt_regs++) {
+            bench_regs_dense[cnt_regs].addr_beg = cnt_regs * BENCH_SPARSE_WIDTH;
+            bench_regs_dense[cnt_regs].addr_end = (cnt_regs * BENCH_SPARSE_WIDTH) + BENCH_SPARSE_WIDTH - 1;
+            bench_regs_dense[cnt_regs].data = bench_data;
+
+            bench_regs_sparse[cnt_regs].addr_beg = ((uint32_t) (cnt_regs % BENCH_SPARSE_BLOCKS) << 30) +
+                                                   ((cnt_regs / BENCH_SPARSE_BLOCKS) * BENCH_SPARSE_STRIDE);
+            bench_regs_sparse[cnt_regs].addr_end = bench_regs_sparse[cnt_regs].addr_beg + BENCH_SPARSE_WIDTH - 1;
+            bench_regs_sparse[cnt_regs].data = bench_data;
+
+            if ((reg_ctx_add(&bench_ctx_dense, &bench_regs_dense[cnt_regs])) ||
+                (reg_ctx_add(&bench_ctx_sparse, &bench_regs_sparse[cnt_regs]))) {
+                pinkie_printf("reg_ctx_add failed at entry %u\n", cnt_regs);
+                return;
+            }
+        }
+
+        ns_dense = bench_regreg_sparse_run(&bench_ctx_dense, bench_regs_dense, cnt_regs);
+        ns_sparse = bench_regreg_sparse_run(&bench_ctx_sparse, bench_regs_sparse, cnt_regs);
+
+        pinkie_printf("  %5u entries: %3u.%u ns/lookup sparse (dense: %u.%u ns/lookup)\n",
+                      cnt_regs,
+                      (unsigned int) (ns_sparse / BENCH_SPARSE_LOOKUPS),
+                      (unsigned int) (((ns_sparse * 10) / BENCH_SPARSE_LOOKUPS) % 10),
+                      (unsigned int) (ns_dense / BENCH_SPARSE_LOOKUPS),
+                      (unsigned int) (((ns_dense * 10) / BENCH_SPARSE_LOOKUPS) % 10));
+    }
+}
+
+
+#endif /* PINKIE_CFG_REGREG_ADDR32 */
@@ -0,0 +1,249 @@
+/**
+ * @brief PINKIE - Ring Benchmark
+ *
+ * Checks the ring edge cases first: wrap around, overflow count and partial
+ * pop. Then a producer and a consumer thread stream a byte sequence through
+ * the ring, once per byte with put/get and with bulk push/pop of growing
+ * chunks. The consumer verifies the sequence, the throughput is reported.
+ *
+ * A thread that can't make progress yields, so the benchmark also finishes
+ * in reasonable time on a single core.
+ *
+ * Copyright (c) 2017, Sven Bachmann <dev@mcbachmann.de>
+ *
+ * Licensed under the MIT license, see LICENSE for details.
+ */
+#define _POSIX_C_SOURCE 200112L
+#include <pthread.h>
+#include <sched.h>
+#include <pinkie_ring.h>
+#include "bench.h"
+
+
+/*****************************************************************************/
+/* Local defines */
+/*****************************************************************************/
+#define BENCH_RING_SIZE                 4096    /**< streaming ring size */
+#define BENCH_RING_BYTES                (4UL * 1024 * 1024) /**< bytes per run */
+#define BENCH_RING_CHUNK_MAX            1024    /**< max chunk size */
+
+/**< sequence byte, the shift catches bytes repeated after 256 positions */
+#define BENCH_RING_SEQ(pos)             ((uint8_t) ((pos) ^ ((pos) >> 8)))
+
+
+/*****************************************************************************/
+/* Local prototypes */
+/*****************************************************************************/
+static unsigned int bench_ring_check(
+    void
+);
+
+static void * bench_ring_producer(
+    void *arg                                   /**< chunk size */
+);
+
+static void * bench_ring_consumer(
+    void *arg                                   /**< chunk size */
+);
+
+
+/*****************************************************************************/
+/* Local variables */
+/*****************************************************************************/
+PINKIE_RING_DEF(bench_ring_small, 16);          /**< edge case ring */
+PINKIE_RING_DEF(bench_ring_stream, BENCH_RING_SIZE);/**< streaming ring */
+
+static const unsigned int bench_chunks[] = {    /**< chunk sizes, 1 = put/get */
+    1, 16, 256, BENCH_RING_CHUNK_MAX
+};
+
+
+/*****************************************************************************/
+/** Check edge cases
+ *
+ * @returns 0 on success, otherwise the failed step
+ */
+static unsigned int bench_ring_check(
+    void
+)
+{
+    PINKIE_RING_T *ring = &bench_ring_small;    /* ring */
+    uint8_t data[32];                           /* data */
+    uint8_t val;                                /* single byte */
+    unsigned int cnt;                           /* counter */
+
+    for (cnt = 0; cnt < sizeof(data); cnt++) {
+        data[cnt] = (uint8_t) cnt;
+    }
+
+    /* empty ring */
+    if (pinkie_ring_get(ring, &val) || pinkie_ring_pop(ring, data, 1) || pinkie_ring_fill(ring)) {
+        return 1;
+    }
+
+    /* move counters near the buffer end */
+    if ((10 != pinkie_ring_push(ring, data, 10)) || (10 != pinkie_ring_pop(ring, &data[16], 10))) {
+        return 2;
+    }
+
+    /* full size is usable, the rest is counted */
+    if ((16 != pinkie_ring_push(ring, data, 20)) || (4 != ring->cnt_ovf) || (16 != pinkie_ring_fill(ring))) {
+        return 3;
+    }
+
+    if (pinkie_ring_put(ring, 0xff) || (5 != ring->cnt_ovf)) {
+        return 4;
+    }
+
+    /* partial pop across the buffer end */
+    memset(&data[16], 0, 16);
+    if ((7 != pinkie_ring_pop(ring, &data[16], 7)) || (9 != pinkie_ring_pop(ring, &data[23], 16))) {
+        return 5;
+    }
+
+    if (memcmp(data, &data[16], 16) || pinkie_ring_fill(ring)) {
+        return 6;
+    }
+
+    /* single bytes */
+    if (!pinkie_ring_put(ring, 0x5a) || !pinkie_ring_get(ring, &val) || (0x5a != val) || pinkie_ring_get(ring, &val)) {
+        return 7;
+    }
+
+    return 0;
+}
+
+
+/*****************************************************************************/
+/** Producer thread
+ *
+ * Only pushes what fits, so the overflow counter must stay zero.
+ */
+static void * bench_ring_producer(
+    void *arg                                   /**< chunk size */
+)
+{
+    unsigned int chunk = (unsigned int) (uintptr_t) arg; /* chunk size */
+    unsigned long pos = 0;                      /* stream position */
+    unsigned int len;                           /* push length */
+    unsigned int cnt;                           /* counter */
+    uint8_t data[BENCH_RING_CHUNK_MAX];         /* chunk data */
+
+    while (pos < BENCH_RING_BYTES) {
+
+        len = BENCH_RING_SIZE - pinkie_ring_fill(&bench_ring_stream);
+        if (!len) {
+            sched_yield();
+            continue;
+        }
+
+        if (1 == chunk) {
+            pos += pinkie_ring_put(&bench_ring_stream, BENCH_RING_SEQ(pos));
+            continue;
+        }
+
+        if (len > chunk) {
+            len = chunk;
+        }
+
+        for (cnt = 0; cnt < len; cnt++) {
+            data[cnt] = BENCH_RING_SEQ(pos + cnt);
+        }
+
+        pos += pinkie_ring_push(&bench_ring_stream, data, len);
+    }
+
+    return NULL;
+}
+
+
+/*****************************************************************************/
+/** Consumer thread
+ *
+ * @returns count of sequence errors
+ */
+static void * bench_ring_consumer(
+    void *arg                                   /**< chunk size */
+)
+{
+    unsigned int chunk = (unsigned int) (uintptr_t) arg; /* chunk size */
+    unsigned long pos = 0;                      /* stream position */
+    uintptr_t err = 0;                          /* sequence errors */
+    unsigned int len;                           /* pop length */
+    unsigned int cnt;                           /* counter */
+    uint8_t data[BENCH_RING_CHUNK_MAX];         /* chunk data */
+
+    while (pos < BENCH_RING_BYTES) {
+
+        if (1 == chunk) {
+            len = pinkie_ring_get(&bench_ring_stream, data);
+        }
+        else {
+            len = pinkie_ring_pop(&bench_ring_stream, data, chunk);
+        }
+
+        if (!len) {
+            sched_yield();
+            continue;
+        }
+
+        for (cnt = 0; cnt < len; cnt++) {
+            err += (BENCH_RING_SEQ(pos + cnt) != data[cnt]);
+        }
+
+        pos += len;
+    }
+
+    return (void *) err;
+}
+
+
+/*****************************************************************************/
+/** Ring benchmark
+ */
+void bench_ring(
+    void
+)
+{
+    unsigned int res;                           /* check result */
+    unsigned int idx;                           /* chunk index */
+    uint64_t ns;                                /* elapsed time */
+    void *err;                                  /* sequence errors */
+    pthread_t thr_prod;                         /* producer thread */
+    pthread_t thr_cons;                         /* consumer thread */
+
+    res = bench_ring_check();
+    if (res) {
+        pinkie_printf("  check: failed at step %u\n", res);
+        return;
+    }
+    pinkie_printf("  check: ok\n");
+
+    for (idx = 0; idx < PINKIE_ARRAY_COUNT(bench_chunks); idx++) {
+
+        bench_ring_stream.cnt_ovf = 0;
+
+        ns = bench_ns();
+        if (pthread_create(&thr_cons, NULL, bench_ring_consumer, (void *) (uintptr_t) bench_chunks[idx])) {
+            pinkie_printf("  thread creation failed\n");
+            return;
+        }
+
+        if (pthread_create(&thr_prod, NULL, bench_ring_producer, (void *) (uintptr_t) bench_chunks[idx])) {
+            pinkie_printf("  thread creation failed\n");
+            pthread_cancel(thr_cons);
+            return;
+        }
+
+        pthread_join(thr_prod, NULL);
+        pthread_join(thr_cons, &err);
+        ns = bench_ns() - ns;
+
+        pinkie_printf("  chunk %4u: %5u MB/s, %2u.%02u ns/byte, %s\n",
+                      bench_chunks[idx],
+                      (unsigned int) ((BENCH_RING_BYTES * 1000ULL) / ns),
+                      (unsigned int) (ns / BENCH_RING_BYTES),
+                      (unsigned int) (((ns * 100) / BENCH_RING_BYTES) % 100),
+                      ((err) || (bench_ring_stream.cnt_ovf)) ? "sequence error" : "sequence ok");
+    }
+}
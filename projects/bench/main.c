@@ -0,0 +1,103 @@
+/**
+ * @brief PINKIE - Benchmarks
+ *
+ * Runs all benchmarks or only the ones given as arguments, e.g.:
+ *   ./build/linux/pinkie regreg
+ *
+ * Copyright (c) 2017, Sven Bachmann <dev@mcbachmann.de>
+ *
+ * Licensed under the MIT license, see LICENSE for details.
+ */
+#define _POSIX_C_SOURCE 199309L
+#include <time.h>
+#include "bench.h"
+
+
+/*****************************************************************************/
+/* Local datatypes */
+/*****************************************************************************/
+typedef struct {
+    const char *name;                           /**< benchmark name */
+    void (*func)(void);                         /**< benchmark function */
+} BENCH_T;
+
+
+/*****************************************************************************/
+/* Local variables */
+/*****************************************************************************/
+static const BENCH_T benchs[] = {               /**< benchmark list */
+    { "fmt", bench_fmt },
+    { "i2s", bench_i2s },
+    { "regreg", bench_regreg },
+    { "regreg_ctx", bench_regreg_ctx },
+    { "regreg_mt", bench_regreg_mt },
+#if PINKIE_CFG_REGREG_ADDR32 == 1
+    { "regreg_sparse", bench_regreg_sparse },
+#endif
+    { "ring", bench_ring },
+};
+
+static uint32_t bench_seed = 1;                 /**< random seed */
+
+
+/*****************************************************************************/
+/** Main
+ */
+int main(
+    int argc,                                   /**< argument count */
+    char **argv                                 /**< arguments */
+)
+{
+    unsigned int cnt;                           /* counter */
+    int arg;                                    /* argument index */
+
+    for (cnt = 0; cnt < PINKIE_ARRAY_COUNT(benchs); cnt++) {
+
+        /* run all benchmarks if no argument was given */
+        for (arg = 1; arg < argc; arg++) {
+            if (!strcmp(argv[arg], benchs[cnt].name)) {
+                break;
+            }
+        }
+
+        if ((1 < argc) && (arg == argc)) {
+            continue;
+        }
+
+        pinkie_printf("%s:\n", benchs[cnt].name);
+        benchs[cnt].func();
+        pinkie_printf("\n");
+    }
+
+    return 0;
+}
+
+
+/*****************************************************************************/
+/** Get monotonic time in nanoseconds
+ */
+uint64_t bench_ns(
+    void
+)
+{
+    struct timespec ts;                         /* timestamp */
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t) ts.tv_sec * 1000000000ULL) + (uint64_t) ts.tv_nsec;
+}
+
+
+/*****************************************************************************/
+/** Pseudo random number generator (xorshift32)
+ */
+uint32_t bench_rand(
+    void
+)
+{
+    bench_seed ^= bench_seed << 13;
+    bench_seed ^= bench_seed >> 17;
+    bench_seed ^= bench_seed << 5;
+
+    return bench_seed;
+}
@@ -0,0 +1,53 @@
+/**
+ * @brief PINKIE - Configuration
+ *
+ * Copyright (c) 2017, Sven Bachmann <dev@mcbachmann.de>
+ *
+ * Licensed under the MIT license, see LICENSE for details.
+ */
+#ifndef PINKIE_CFG_H
+#define PINKIE_CFG_H
+
+
+/* Configure the highest integer width that must be supported by printf.
+ *
+ * Allowed values are:
+ *   1 - 8-bit
+ *   2 - 16-bit
+ *   4 - 32-bit
+ *   8 - 64-bit
+ */
+#define PINKIE_CFG_PRINTF_MAX_INT       8
+
+
+/* Configure the highest integer width that must be supported by sscanf.
+ *
+ * Allowed values are:
+ *   1 - 8-bit
+ *   2 - 16-bit
+ *   4 - 32-bit
+ *   8 - 64-bit
+ */
+#define PINKIE_CFG_SSCANF_MAX_INT       8
+
+
+/* Configure the maximum count of RegReg register entries. Each entry uses one
+ * pointer in the sorted register index.
+ */
+#define PINKIE_CFG_REGREG_ENTRIES       10000
+
+
+/* Allow concurrent RegReg access from multiple threads. Lookups are lock-free,
+ * register accesses are serialized per entry.
+ */
+#define PINKIE_CFG_REGREG_CONCURRENT    1
+
+
+/* Use 32-bit RegReg addresses. Each context keeps a page table with the
+ * given count of pages, one page per used 16M address block.
+ */
+#define PINKIE_CFG_REGREG_ADDR32        1
+#define PINKIE_CFG_REGREG_PAGES         4
+
+
+#endif /* PINKIE_CFG_H */
@@ -31,4 +31,11 @@
 #define PINKIE_CFG_SSCANF_MAX_INT       8
 
 
+/* Configure the pinkie_printf stack buffer. The output of each call is
+ * collected and passed to standard output in blocks instead of character by
+ * character. 0 disables the buffer.
+ */
+#define PINKIE_CFG_PRINTF_BUF_LEN       64
+
+
 #endif /* PINKIE_CFG_H */
@@ -58,6 +58,10 @@ sub PINKIE_req_add($$$;$);
 #
 # PINKIE Device Descriptions
 #
+# Register offsets match devices built with 16 bit register addresses. With
+# PINKIE_CFG_REGREG_ADDR32 address fields take 4 bytes and move the following
+# fields, e.g. pend_res and pend_full.
+#
 my %PINKIE_Devices = (
     "generic" => {
 
@@ -195,6 +199,60 @@ my %PINKIE_Devices = (
             },
         },
     },
+
+    "regreg" => {
+        "meta" => {
+            "reg_base" => 5000,
+        },
+
+        "regs" => {
+            "ann_flush" => {
+                "reg" => 0,
+                "datatype" => "uint16",
+                "unit" => "ms",
+            },
+
+            "ann_overflow" => {
+                "reg" => 2,
+                "datatype" => "uint16",
+                "attr" => "ro",
+            },
+
+            "cache_hit" => {
+                "reg" => 100,
+                "datatype" => "uint16",
+                "attr" => "ro",
+            },
+
+            "cache_miss" => {
+                "reg" => 102,
+                "datatype" => "uint16",
+                "attr" => "ro",
+            },
+
+            "pend_addr" => {
+                "reg" => 200,
+                "datatype" => "uint16",
+                "attr" => "ro",
+            },
+
+            "pend_res" => {
+                "reg" => 202,
+                "datatype" => "uint8",
+                "attr" => "ro",
+                "map" => {
+                    "0" => "done",
+                    "1" => "failed",
+                },
+            },
+
+            "pend_full" => {
+                "reg" => 203,
+                "datatype" => "uint8",
+                "attr" => "ro",
+            },
+        },
+    },
 );
 
 
@@ -615,6 +673,8 @@ sub PINKIE_Read($)
     my $reg;
     my $reg_name;
     my $val;
+    my $val_typed;
+    my $val_line;
     my $rr_list;
     my $msg;
     my $dev;
@@ -665,6 +725,20 @@ sub PINKIE_Read($)
             }
         }
 
+        # split coalesced announcements into single register lines
+        if ($msg =~ m/^(\d+):((?: 0x[0-9a-fA-F]+){2,}) \(\)$/) {
+            my $reg_split = $1;
+            my $buf_split = "";
+
+            foreach my $byte (split(' ', $2)) {
+                $buf_split .= "$reg_split: $byte ()\n";
+                $reg_split++;
+            }
+
+            $hash->{io}->{buf_rx} = $buf_split . $hash->{io}->{buf_rx};
+            next;
+        }
+
         # parse line
         if ($msg !~ m/(\d+?): (0x.*?) /) {
             next;
@@ -673,6 +747,12 @@ sub PINKIE_Read($)
         $reg = $1;
         $val = hex($2);
 
+        # typed announcements carry the whole value, e.g. "2000: 0x011a (u16)"
+        $val_typed = undef;
+        if ($msg =~ m/^\d+: 0x([0-9a-fA-F]+) \([ui]\d+\)$/) {
+            $val_typed = $1;
+        }
+
         # find register by iterating over register sets
         $reg_set_ofs = PINKIE_REG_ADDR_MAX;
         $reg_set = undef;
@@ -739,38 +819,43 @@ sub PINKIE_Read($)
         }
         PINKIE_LogDbg($name, "Read: found register $reg_set:$reg_found:$reg_ofs");
 
-        # store register data
-        $modules{PINKIE}{PINKIE_hosts}{$name}{PINKIE_reg_tmp}{$reg_set}{$reg_found}[$reg_ofs] = $val;
+        # typed value is complete, no fragments to reassemble
+        if (defined($val_typed) and (0 == $reg_ofs)) {
+            $val_line = $val_typed;
+        } else {
+            # store register data
+            $modules{PINKIE}{PINKIE_hosts}{$name}{PINKIE_reg_tmp}{$reg_set}{$reg_found}[$reg_ofs] = $val;
 
-        # if not last register fragment then leave
-        if ($reg_set_ofs < $reg_end) {
-            next;
-        }
-        PINKIE_LogDbg($name, "Read: read all register fragments");
+            # if not last register fragment then leave
+            if ($reg_set_ofs < $reg_end) {
+                next;
+            }
+            PINKIE_LogDbg($name, "Read: read all register fragments");
 
-        # convert register fragments to value
-        my $val_line = "";
-        my $data_reg = $modules{PINKIE}{PINKIE_hosts}{$name}{PINKIE_reg_tmp}{$reg_set}{$reg_found};
-        @{$data_reg} = reverse(@{$data_reg});
+            # convert register fragments to value
+            $val_line = "";
+            my $data_reg = $modules{PINKIE}{PINKIE_hosts}{$name}{PINKIE_reg_tmp}{$reg_set}{$reg_found};
+            @{$data_reg} = reverse(@{$data_reg});
 
-        # build hex string from value array
-        for my $cnt (0 .. $#{$data_reg}) {
+            # build hex string from value array
+            for my $cnt (0 .. $#{$data_reg}) {
 
-            PINKIE_LogDbg($name, "Read: $reg_set:$reg_found:$cnt");
+                PINKIE_LogDbg($name, "Read: $reg_set:$reg_found:$cnt");
 
-            if (!defined(@{$data_reg}[$cnt])) {
-                PINKIE_LogWarn($name, "PINKIE_Read: incomplete register read \"$reg_set:$reg_found\", dropping values");
-                undef $modules{PINKIE}{PINKIE_hosts}{$name}{PINKIE_reg_tmp}{$reg_set}{$reg_found};
-                $val_line = undef;
-                last;
-            }
+                if (!defined(@{$data_reg}[$cnt])) {
+                    PINKIE_LogWarn($name, "PINKIE_Read: incomplete register read \"$reg_set:$reg_found\", dropping values");
+                    undef $modules{PINKIE}{PINKIE_hosts}{$name}{PINKIE_reg_tmp}{$reg_set}{$reg_found};
+                    $val_line = undef;
+                    last;
+                }
 
-            $val_line .= sprintf("%02x", @{$data_reg}[$cnt]);
-        }
+                $val_line .= sprintf("%02x", @{$data_reg}[$cnt]);
+            }
 
-        # check if register read failed
-        if (!defined($val_line)) {
-            next;
+            # check if register read failed
+            if (!defined($val_line)) {
+                next;
+            }
         }
 
         # convert value to decimal
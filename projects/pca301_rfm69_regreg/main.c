@@ -27,6 +27,12 @@
 #include <acyclic.h>
 #include <regreg.h>
 #include <regreg_acyclic.h>
+#include <regreg_ann.h>
+#include <regreg_trig.h>
+#include <regreg_sample.h>
+#include <regreg_txn.h>
+#include <regreg_nvs.h>
+#include <pinkie_log.h>
 #include <pca301_rfm69.h>
 
 
@@ -36,7 +42,19 @@
 #define DEVICE_ID                   0x01UL      /**< device id */
 #define DEVICE_VERSION              1           /**< device version */
 
+#define REG_BASE_ATMEGA             2000        /**< regreg base ATmega */
+#define REG_BASE_RFM69              3000        /**< regreg base RFM69 */
 #define REG_BASE_PCA301             4100        /**< regreg base PCA301 */
+#define REG_BASE_ANN                5000        /**< regreg base announcement queue */
+#define REG_BASE_CACHE              5100        /**< regreg base cache statistics */
+#define REG_BASE_PEND               5200        /**< regreg base pending writes */
+#define REG_BASE_TRIG               5300        /**< regreg base register triggers */
+#define REG_BASE_SAMPLE             5400        /**< regreg base sampling table */
+#define REG_BASE_TXN                5500        /**< regreg base write transactions */
+#define REG_BASE_STATS              5600        /**< regreg base access statistics */
+#define REG_BASE_NVS                5700        /**< regreg base NVS write-back */
+#define REG_BASE_UART               5800        /**< regreg base UART statistics */
+#define REG_BASE_LOG                5900        /**< regreg base log level */
 
 #define REG_ATMEGA_TEMP             0           /**< ATmega temperature */
 #define REG_ATMEGA_VOLT             2           /**< ATmega voltage */
@@ -53,6 +71,10 @@
 
 #define RFM69_IS_HW                 1           /**< RFM69 is HW variant flag */
 
+#define PROJ_CACHE_TTL_ADC          10000       /**< ADC value cache TTL in ms */
+#define PROJ_CACHE_TTL_RFM69_TEMP   10000       /**< RFM69 temperature cache TTL in ms */
+#define PROJ_CACHE_TTL_RFM69_RSSI   1000        /**< RFM69 RSSI cache TTL in ms */
+
 #define PROJECT_PCA301_CNT          10          /**< store up to 10 devices */
 
 
@@ -77,6 +99,7 @@ typedef struct {
     int16_t val_atmega_volt_corr;               /**< ATmega voltage correction */
 
     PCA301_RFM69_NVS_T pca301_rfm69_nvs;        /**< PCA301 RFM69 data */
+    REGREG_SAMPLE_NVS_T regreg_sample_nvs;      /**< RegReg sampling table */
 } __attribute__((packed)) PROJECT_NVS_T;
 
 
@@ -107,6 +130,22 @@ static unsigned int flg_nvs_valid = 0;          /**< NVS valid flag */
 static PROJECT_NVS_T data_nvs;                  /**< NVS data */
 static REG_ATMEGA_T data_atmega;                /**< ATmega data */
 
+static const PINKIE_FMT_OP_T fmt_ann_typed[] = { /**< announcement "addr: 0x" */
+    PINKIE_FMT_U(REG_ADDR_T), PINKIE_FMT_TEXT(": 0x"), PINKIE_FMT_END
+};
+static const PINKIE_FMT_OP_T fmt_ann_typed_byte[] = { /**< announcement typed byte */
+    PINKIE_FMT_X0(uint8_t, 2), PINKIE_FMT_END
+};
+static const PINKIE_FMT_OP_T fmt_ann_typed_end[] = { /**< announcement " (u16)\n" */
+    PINKIE_FMT_TEXT(" ("), PINKIE_FMT_C, PINKIE_FMT_U(unsigned int), PINKIE_FMT_TEXT(")\n"), PINKIE_FMT_END
+};
+static const PINKIE_FMT_OP_T fmt_ann_addr[] = { /**< announcement "addr:" */
+    PINKIE_FMT_U(REG_ADDR_T), PINKIE_FMT_TEXT(":"), PINKIE_FMT_END
+};
+static const PINKIE_FMT_OP_T fmt_ann_byte[] = { /**< announcement " 0xval" */
+    PINKIE_FMT_TEXT(" 0x"), PINKIE_FMT_X(uint8_t), PINKIE_FMT_END
+};
+
 static uint8_t data_device[5] = {               /**< device data */
     DEVICE_ID & 0xff,
     (DEVICE_ID >> 8) & 0xff,
@@ -115,37 +154,28 @@ static uint8_t data_device[5] = {               /**< device data */
     DEVICE_VERSION,
 };
 
-static REG_ENTRY_T reg_info_device = {          /**< device register */
-    NULL,
-    0,
-    sizeof(data_device) - 1,
-    NULL,
-    data_device,
-};
 
-static REG_ENTRY_T reg_info_nvs = {             /**< NVS register */
-    NULL,
-    1000,
-    1000 + sizeof(PROJECT_NVS_T) - 1,
-    reg_nvs,
-    &data_nvs,
-};
-
-static REG_ENTRY_T reg_info_atmega = {          /**< ATmega register */
-    NULL,
-    2000,
-    2000 + 11,
-    reg_atmega,
-    &data_atmega,
-};
-
-static REG_ENTRY_T reg_info_rfm69 = {           /**< RFM69 register */
-    NULL,
-    3000,
-    3000 + PROJ_RFM69_REG_BUDGET,
-    reg_rfm69,
-    NULL,
-};
+/*****************************************************************************/
+/* Register definitions */
+/*****************************************************************************/
+REGREG_ENTRY(reg_info_device, 0, sizeof(data_device) - 1, NULL, data_device);
+REGREG_ENTRY_NVS(reg_info_nvs, 1000, 1000 + sizeof(PROJECT_NVS_T) - 1, reg_nvs, &data_nvs);
+
+/* ADC conversions and RFM69 measurements are slow, so their values are cached */
+REGREG_CACHE(cache_atmega_temp, PROJ_CACHE_TTL_ADC, sizeof(uint16_t));
+REGREG_CACHE(cache_atmega_volt, PROJ_CACHE_TTL_ADC, sizeof(uint16_t));
+REGREG_CACHE(cache_rfm69_temp, PROJ_CACHE_TTL_RFM69_TEMP, 1);
+REGREG_CACHE(cache_rfm69_rssi, PROJ_CACHE_TTL_RFM69_RSSI, 1);
+
+REGREG_ENTRY_CACHED_TYPED(reg_info_atmega_temp, REG_BASE_ATMEGA + REG_ATMEGA_TEMP, REG_BASE_ATMEGA + REG_ATMEGA_VOLT - 1, reg_atmega, &data_atmega.temp, cache_atmega_temp, REGREG_TYPE_U16);
+REGREG_ENTRY_CACHED_TYPED(reg_info_atmega_volt, REG_BASE_ATMEGA + REG_ATMEGA_VOLT, REG_BASE_ATMEGA + REG_ATMEGA_MS - 1, reg_atmega, &data_atmega.volt, cache_atmega_volt, REGREG_TYPE_U16);
+REGREG_ENTRY_TYPED(reg_info_atmega_ms, REG_BASE_ATMEGA + REG_ATMEGA_MS, REG_BASE_ATMEGA + sizeof(REG_ATMEGA_T) - 1, reg_atmega, &data_atmega.ms, REGREG_TYPE_U64);
+REGREG_ENTRY(reg_info_rfm69, REG_BASE_RFM69, REG_BASE_RFM69 + PROJ_RFM69_REG_TEMP - 1, reg_rfm69, NULL);
+REGREG_ENTRY_CACHED(reg_info_rfm69_temp, REG_BASE_RFM69 + PROJ_RFM69_REG_TEMP, REG_BASE_RFM69 + PROJ_RFM69_REG_TEMP, reg_rfm69, NULL, cache_rfm69_temp);
+REGREG_ENTRY_CACHED(reg_info_rfm69_rssi, REG_BASE_RFM69 + PROJ_RFM69_REG_RSSI, REG_BASE_RFM69 + PROJ_RFM69_REG_RSSI, reg_rfm69, NULL, cache_rfm69_rssi);
+REGREG_ENTRY(reg_info_rfm69_ctrl, REG_BASE_RFM69 + PROJ_RFM69_REG_OSC, REG_BASE_RFM69 + PROJ_RFM69_REG_BUDGET, reg_rfm69, NULL);
+REGREG_ENTRY(reg_info_uart, REG_BASE_UART, REG_BASE_UART + sizeof(PINKIE_ARCH_UART_REG_T) - 1, NULL, &pinkie_arch_uart_reg);
+REGREG_ENTRY(reg_info_log, REG_BASE_LOG, REG_BASE_LOG + sizeof(pinkie_log_lvl) - 1, NULL, &pinkie_log_lvl);
 
 
 /*****************************************************************************/
@@ -183,11 +213,11 @@ int main(
     /* initialize SPI */
     pinkie_spi_init();
 
-    /* create RegReg registers */
-    reg_add(&reg_info_device);
-    reg_add(&reg_info_nvs);
-    reg_add(&reg_info_atmega);
-    reg_add(&reg_info_rfm69);
+    /* check RegReg registers */
+    res = reg_init();
+    if (res) {
+        goto _bail;
+    }
 
     /* initialize RFM69 transmitter */
     if (!flg_nvs_valid) {
@@ -209,7 +239,58 @@ int main(
 
     /* initialize PCA301 socket driver */
     pca301_rfm69_init(flg_nvs_valid, &data_nvs.pca301_rfm69_nvs);
-    pca301_init(REG_BASE_PCA301);
+    res = pca301_init(REG_BASE_PCA301);
+    if (res) {
+        goto _bail;
+    }
+
+    /* initialize announcement queue */
+    res = reg_ann_init(REG_BASE_ANN);
+    if (res) {
+        goto _bail;
+    }
+
+    /* initialize cache statistics */
+    res = reg_cache_init(REG_BASE_CACHE);
+    if (res) {
+        goto _bail;
+    }
+
+    /* initialize pending write queue */
+    res = reg_pend_init(REG_BASE_PEND);
+    if (res) {
+        goto _bail;
+    }
+
+    /* initialize register triggers */
+    res = reg_trig_init(REG_BASE_TRIG);
+    if (res) {
+        goto _bail;
+    }
+
+    /* initialize sampling scheduler */
+    res = reg_sample_init(REG_BASE_SAMPLE, flg_nvs_valid, &data_nvs.regreg_sample_nvs);
+    if (res) {
+        goto _bail;
+    }
+
+    /* initialize write transactions */
+    res = reg_txn_init(REG_BASE_TXN);
+    if (res) {
+        goto _bail;
+    }
+
+    /* initialize access statistics */
+    res = reg_stat_init(REG_BASE_STATS);
+    if (res) {
+        goto _bail;
+    }
+
+    /* initialize NVS write-back */
+    res = reg_nvs_init(REG_BASE_NVS, flg_nvs_valid, &data_nvs, sizeof(data_nvs));
+    if (res) {
+        goto _bail;
+    }
 
     /* initialize CLI */
     pinkie_printf("System: ready\n");
@@ -235,6 +316,11 @@ int main(
 
         pca301_process();
         pca301_rfm69_process();
+        reg_pend_process();
+        reg_trig_process();
+        reg_sample_process();
+        reg_nvs_process();
+        reg_ann_process();
     }
 
     pinkie_stdio_exit();
@@ -264,11 +350,13 @@ static unsigned int reg_nvs(
         if (0 == reg_acc->addr_ofs) {
             pinkie_printf("NVS: write\n");
             pinkie_nvs_write((uint8_t *) &data_nvs, sizeof(data_nvs));
+            reg_nvs_sync(1);
             return 0;
         }
         else if (1 == reg_acc->addr_ofs) {
             pinkie_printf("NVS: invalidate\n");
             pinkie_nvs_write((uint8_t *) &reg_acc->addr_ofs, sizeof(uint16_t));
+            reg_nvs_sync(0);
             return 0;
         }
     }
@@ -289,11 +377,14 @@ static unsigned int reg_atmega(
     struct REG_ACC_T *reg_acc                   /**< register access info */
 )
 {
-    ACYCLIC_UNUSED(reg);
+    uint16_t ofs;                               /* ATmega register offset */
+
+    /* the ATmega registers are split into entries, so use the block offset */
+    ofs = reg->addr_beg - REG_BASE_ATMEGA + reg_acc->addr_ofs;
 
     /* read ATmega temperature (see manual chapter "Temperature Measurement") */
-    if ((REG_ATMEGA_TEMP == reg_acc->addr_ofs) ||
-        (REG_ATMEGA_VOLT == reg_acc->addr_ofs)) {
+    if ((REG_ATMEGA_TEMP == ofs) ||
+        (REG_ATMEGA_VOLT == ofs)) {
 
         /* temp and voltage aren't writeable */
         if (reg_acc->write_flg) {
@@ -301,7 +392,7 @@ static unsigned int reg_atmega(
         }
 
         /* select internal 1.1V voltage reference and enable channel ADC8 */
-        ADMUX = (REG_ATMEGA_TEMP == reg_acc->addr_ofs) ? ((1 << REFS1) | (1 << REFS0) | (1 << MUX3)) : ((1 << REFS0) | (1 << MUX3) | (1 << MUX2) | (1 << MUX1));
+        ADMUX = (REG_ATMEGA_TEMP == ofs) ? ((1 << REFS1) | (1 << REFS0) | (1 << MUX3)) : ((1 << REFS0) | (1 << MUX3) | (1 << MUX2) | (1 << MUX1));
 
         /* enable ADC and set the prescaler to div factor 16 */
         ADCSRA = (1 << ADEN) | (0x06 << ADPS0);
@@ -316,14 +407,14 @@ static unsigned int reg_atmega(
         while (ADCSRA & (1 << ADSC));
 
         /* fetch the result in mV and use the given 25 °C as reference */
-        if (REG_ATMEGA_TEMP == reg_acc->addr_ofs) {
+        if (REG_ATMEGA_TEMP == ofs) {
             data_atmega.temp = ADCW + data_nvs.val_atmega_temp_corr;
         } else {
             data_atmega.volt = (1100L * PROJ_ATMEGA_VAL_VOLT_CORR) / ADCW;
         }
     }
     /* read timestamp in ms */
-    else if (REG_ATMEGA_MS == reg_acc->addr_ofs) {
+    else if (REG_ATMEGA_MS == ofs) {
         if (!reg_acc->write_flg) {
             data_atmega.ms = pinkie_timer_get();
         } else {
@@ -344,13 +435,16 @@ static unsigned int reg_rfm69(
     struct REG_ACC_T *reg_acc                   /**< register access info */
 )
 {
-    ACYCLIC_UNUSED(reg);
+    uint16_t ofs;                               /* RFM69 register offset */
+
+    /* the RFM69 registers are split into entries, so use the block offset */
+    ofs = reg->addr_beg - REG_BASE_RFM69 + reg_acc->addr_ofs;
 
     /* inform caller that only 1 register can be read per call */
     reg_acc->data_len = 1;
 
     /* check for invalid register access */
-    switch (reg_acc->addr_ofs) {
+    switch (ofs) {
 
         /* 117: read send time budget in sec */
         case PROJ_RFM69_REG_BUDGET:
@@ -390,9 +484,9 @@ static unsigned int reg_rfm69(
         /* 0 - 113: RFM69 registers */
         default:
             if (!reg_acc->write_flg) {
-                *reg_acc->data.write_to = rfm69_reg_read_raw(reg_acc->addr_ofs);
+                *reg_acc->data.write_to = rfm69_reg_read_raw(ofs);
             } else {
-                rfm69_reg_write_raw(reg_acc->addr_ofs, *reg_acc->data.read_from);
+                rfm69_reg_write_raw(ofs, *reg_acc->data.read_from);
             }
     }
 
@@ -426,21 +520,59 @@ void rfm69_int_ctrl(
 
 
 /*****************************************************************************/
-/** Announce register content to client
+/** Send announcement record to client
  *
- * This function sends the content of the data pointer to the listening client.
- * It doesn't internally update the register so a following read can produce
- * other or no results. This depends on the caller.
+ * Consecutive untyped registers are sent as one line, e.g.
+ * "4100: 0x01 0x02 0x03 ()". Typed values are sent as a whole with their type,
+ * e.g. "2000: 0x011a (u16)". The formats are precompiled, as announcements are
+ * the most frequent output.
  */
-void reg_ann(
-    uint16_t addr,                              /**< register address */
-    void *data,                                 /**< data */
+void reg_ann_send(
+    REG_ADDR_T addr,                            /**< register address */
+    const uint8_t *data,                        /**< data */
     unsigned int len                            /**< data length */
 )
 {
     unsigned int cnt;                           /* counter */
+    unsigned int cnt_bytes = 0;                 /* untyped bytes in line */
+    unsigned int width;                         /* value width */
+    uint8_t type;                               /* value type */
+
+    while (len) {
+        type = reg_type(addr);
+        width = REGREG_TYPE_WIDTH(type);
+
+        if ((1 < width) && (width <= len)) {
+
+            /* finish line of untyped bytes */
+            if (cnt_bytes) {
+                pinkie_printf(" ()\n");
+                cnt_bytes = 0;
+            }
+
+            /* send value most significant byte first */
+            pinkie_printf_fmt(fmt_ann_typed, addr);
+            for (cnt = 0; cnt < width; cnt++) {
+                pinkie_printf_fmt(fmt_ann_typed_byte, data[(type & REGREG_TYPE_BE) ? cnt : (width - 1 - cnt)]);
+            }
+            pinkie_printf_fmt(fmt_ann_typed_end, (type & REGREG_TYPE_SIGNED) ? 'i' : 'u', width * 8);
+
+        } else {
+            width = 1;
+
+            if (!cnt_bytes) {
+                pinkie_printf_fmt(fmt_ann_addr, addr);
+            }
+            pinkie_printf_fmt(fmt_ann_byte, *data);
+            cnt_bytes++;
+        }
+
+        addr += width;
+        data += width;
+        len -= width;
+    }
 
-    for (cnt = 0; cnt < len; cnt++) {
-        pinkie_printf("%u: 0x%"PRIx8" ()\n", addr + cnt, ((uint8_t *) data)[cnt]);
+    if (cnt_bytes) {
+        pinkie_printf(" ()\n");
     }
 }
@@ -15,6 +15,7 @@
  */
 #include <pinkie.h>
 #include <regreg.h>
+#include <pinkie_log.h>
 #include "pca301.h"
 
 
@@ -71,69 +72,70 @@ static PCA301_REGREG_T pca301_regreg_data = {
     PCA301_DFL_FLG_FRAME_DUMP,                  /* dump frame */
 };
 
-static REG_ENTRY_T pca301_regreg_info = {       /**< PCA301 register */
-    NULL,
-    0,
-    sizeof(PCA301_REGREG_T) - 1,
-    pca301_regreg,
-    &pca301_regreg_data,
-};
+REGREG_STAT_DEF(pca301_regreg_info)            /**< PCA301 register statistics */
+
+static REG_ENTRY_T pca301_regreg_info =         /**< PCA301 register */
+    REGREG_ENTRY_INIT_STAT(0, sizeof(PCA301_REGREG_T) - 1, pca301_regreg, &pca301_regreg_data, NULL, REGREG_TYPE_NONE, REGREG_STAT_REF(pca301_regreg_info));
 
 
 /*****************************************************************************/
 /** PCA301 Initialization
+ *
+ * @returns reg_add() result
  */
-void pca301_init(
+unsigned int pca301_init(
     uint16_t rr_base                            /**< regreg base address */
 )
 {
     /* regreg base address */
     pca301_regreg_info.addr_beg = rr_base;
-    pca301_regreg_info.addr_end = rr_base + sizeof(pca301_regreg_data);
+    pca301_regreg_info.addr_end = rr_base + sizeof(pca301_regreg_data) - 1;
 
     /* create RegReg registers */
-    reg_add(&pca301_regreg_info);
+    return reg_add(&pca301_regreg_info);
 }
 
 
 /*****************************************************************************/
 /** PCA301 Data Dumper
+ *
+ * Dumps independent of the log level, callers decide when to dump.
  */
 void pca301_dump(
     PCA301_FRAME_T *pca301                      /**< PCA301 data */
 )
 {
     pinkie_stdio_putc('\n');
-    pinkie_printf("channel: %u\n", pca301->chan);
-    pinkie_printf("command: %u\n", pca301->cmd);
-    pinkie_printf("addr: 0x%x 0x%x 0x%x\n", pca301->addr[0], pca301->addr[1], pca301->addr[2]);
-    pinkie_printf("data: 0x%x\n", pca301->data);
-    pinkie_printf("cons: %u Wh\n", PINKIE_BE16TOH(pca301->cons_be16));
-    pinkie_printf("cons_tot: %u kWh\n", PINKIE_BE16TOH(pca301->cons_tot_be16));
-    pinkie_printf("crc16: 0x%x\n", PINKIE_BE16TOH(pca301->crc16_be16));
+    PINKIE_LOG("channel: %u\n", pca301->chan);
+    PINKIE_LOG("command: %u\n", pca301->cmd);
+    PINKIE_LOG("addr: 0x%x 0x%x 0x%x\n", pca301->addr[0], pca301->addr[1], pca301->addr[2]);
+    PINKIE_LOG("data: 0x%x\n", pca301->data);
+    PINKIE_LOG("cons: %u Wh\n", PINKIE_BE16TOH(pca301->cons_be16));
+    PINKIE_LOG("cons_tot: %u kWh\n", PINKIE_BE16TOH(pca301->cons_tot_be16));
+    PINKIE_LOG("crc16: 0x%x\n", PINKIE_BE16TOH(pca301->crc16_be16));
     pinkie_stdio_putc('\n');
 
-    pinkie_printf("command: ");
+    PINKIE_LOG("command: ");
     switch (pca301->cmd) {
 
         case PCA301_CMD_POLL:
-            pinkie_printf("query, data: %s\n", (PCA301_CMD_SWITCH_ON == pca301->data) ? "on" : "off");
+            PINKIE_LOG("query, data: %s\n", (PCA301_CMD_SWITCH_ON == pca301->data) ? "on" : "off");
             break;
 
         case PCA301_CMD_SWITCH:
-            pinkie_printf("switch, data: %s\n", (PCA301_CMD_SWITCH_ON == pca301->data) ? "on" : "off");
+            PINKIE_LOG("switch, data: %s\n", (PCA301_CMD_SWITCH_ON == pca301->data) ? "on" : "off");
             break;
 
         case PCA301_CMD_IDENT:
-            pinkie_printf("ident, data: %u\n", pca301->data);
+            PINKIE_LOG("ident, data: %u\n", pca301->data);
             break;
 
         case PCA301_CMD_PAIR:
-            pinkie_printf("pair, data: %u\n", pca301->data);
+            PINKIE_LOG("pair, data: %u\n", pca301->data);
             break;
 
         default:
-            pinkie_printf("unknown\n");
+            PINKIE_LOG("unknown\n");
     }
 
     pinkie_stdio_putc('\n');
@@ -239,9 +241,9 @@ void pca301_recv(
             cons = PINKIE_BE16TOH(pca301->cons_tot_be16);
             reg_ann(pca301_regreg_info.addr_beg + PCA301_REGREG_REG_CONS_TOT, &cons, sizeof(cons));
 
-            pinkie_printf("pca301: poll, addr = 0x%02x%02x%02x, state = %u, cons: %u, cons_tot: %u, rssi: %i\n",
-                          pca301->addr[0], pca301->addr[1], pca301->addr[2],
-                          pca301->data, PINKIE_BE16TOH(pca301->cons_be16), PINKIE_BE16TOH(pca301->cons_tot_be16), rssi);
+            PINKIE_LOG_INFO("pca301: poll, addr = 0x%02x%02x%02x, state = %u, cons: %u, cons_tot: %u, rssi: %i\n",
+                            pca301->addr[0], pca301->addr[1], pca301->addr[2],
+                            pca301->data, PINKIE_BE16TOH(pca301->cons_be16), PINKIE_BE16TOH(pca301->cons_tot_be16), rssi);
 
             break;
 
@@ -271,9 +273,9 @@ void pca301_recv(
             cmd = pca301->data ? PCA301_REGREG_CMD_ON : PCA301_REGREG_CMD_OFF;
             reg_ann(pca301_regreg_info.addr_beg + PCA301_REGREG_REG_CMD, &cmd, sizeof(cmd));
 
-            pinkie_printf("pca301: switch ack, addr = 0x%02x%02x%02x, state = %u, rssi = %i\n",
-                          pca301->addr[0], pca301->addr[1], pca301->addr[2],
-                          pca301->data, rssi);
+            PINKIE_LOG_INFO("pca301: switch ack, addr = 0x%02x%02x%02x, state = %u, rssi = %i\n",
+                            pca301->addr[0], pca301->addr[1], pca301->addr[2],
+                            pca301->data, rssi);
 
             break;
     }
@@ -302,7 +304,12 @@ PINKIE_RES_T pca301_send(
                                            sizeof(PCA301_FRAME_T) - sizeof(pca301_frame.crc16_be16),
                                            PCA301_CRC_POLY);
     pca301_frame.crc16_be16 = PINKIE_HTOBE16(pca301_frame.crc16_be16);
-    pca301_dump(&pca301_frame);
+
+    /* dump sent frames if enabled or on debug level */
+    if ((pca301_regreg_data.flg_frame_dump) || (PINKIE_LOG_ENABLED(PINKIE_LOG_LVL_DBG))) {
+        pca301_dump(&pca301_frame);
+    }
+
     res = pca301_plat_send(&pca301_frame);
 
     /* handle send errors */
@@ -366,7 +373,7 @@ static unsigned int pca301_regreg(
     switch (*reg_acc->data.read_from) {
 
         case PCA301_REGREG_CMD_ON:
-            pinkie_printf("pca301: cmd = switch on\n");
+            PINKIE_LOG_INFO("pca301: cmd = switch on\n");
             pca301_cmd = PCA301_CMD_SWITCH;
             pca301_data = PCA301_CMD_SWITCH_ON;
             pca301_tout = pinkie_timer_get() + (uint64_t) pca301_regreg_data.tout_res;
@@ -374,7 +381,7 @@ static unsigned int pca301_regreg(
             break;
 
         case PCA301_REGREG_CMD_OFF:
-            pinkie_printf("pca301: cmd = switch off\n");
+            PINKIE_LOG_INFO("pca301: cmd = switch off\n");
             pca301_cmd = PCA301_CMD_SWITCH;
             pca301_data = PCA301_CMD_SWITCH_OFF;
             pca301_tout = pinkie_timer_get() + (uint64_t) pca301_regreg_data.tout_res;
@@ -382,13 +389,13 @@ static unsigned int pca301_regreg(
             break;
 
         case PCA301_REGREG_CMD_IDENT:
-            pinkie_printf("pca301: cmd = identify (blink)\n");
+            PINKIE_LOG_INFO("pca301: cmd = identify (blink)\n");
             pca301_cmd = PCA301_CMD_IDENT;
             pca301_data = 0;
             break;
 
         case PCA301_REGREG_CMD_POLL:
-            pinkie_printf("pca301: cmd = poll\n");
+            PINKIE_LOG_INFO("pca301: cmd = poll\n");
             pca301_cmd = PCA301_CMD_POLL;
             pca301_data = 0;
             pca301_tout = pinkie_timer_get() + (uint64_t) pca301_regreg_data.tout_res;
@@ -396,7 +403,7 @@ static unsigned int pca301_regreg(
             break;
 
         case PCA301_REGREG_CMD_STATS_RESET:
-            pinkie_printf("pca301: cmd = stats reset\n");
+            PINKIE_LOG_INFO("pca301: cmd = stats reset\n");
             pca301_cmd = PCA301_CMD_POLL;
             pca301_data = PCA301_CMD_POLL_STATS_RESET;
             pca301_tout = pinkie_timer_get() + (uint64_t) pca301_regreg_data.tout_res;
@@ -404,7 +411,7 @@ static unsigned int pca301_regreg(
             break;
 
         default:
-            pinkie_printf("pca301: unknown cmd\n");
+            PINKIE_LOG_WARN("pca301: unknown cmd\n");
             return 0;
     }
 
@@ -466,7 +473,7 @@ void pca301_process(
     /* poll device if a uninitiated switch was detected */
     if (pca301_poll_flag) {
 
-        pinkie_printf("pca301: cmd = auto-poll\n");
+        PINKIE_LOG_INFO("pca301: cmd = auto-poll\n");
         memcpy(pca301_addr, pca301_poll_addr, sizeof(pca301_addr));
         pca301_chan = pca301_poll_chan;
         pca301_cmd = PCA301_CMD_POLL;
@@ -104,14 +104,14 @@ typedef struct {
     uint16_t tout_res;                          /**< [rr:14-15] response timeout */
     uint8_t retries;                            /**< [rr:16] retry attempts on timeout */
     uint8_t flg_poll_auto;                      /**< [rr:17] poll socket if switch is detected */
-    uint8_t flg_frame_dump;                     /**< [rr:18] dump frames */
+    uint8_t flg_frame_dump;                     /**< [rr:18] dump frames, independent of log level */
 } __attribute__((packed)) PCA301_REGREG_T;
 
 
 /*****************************************************************************/
 /* Prototypes */
 /*****************************************************************************/
-void pca301_init(
+unsigned int pca301_init(
     uint16_t rr_base                            /**< regreg base address */
 );
 
@@ -31,4 +31,77 @@
 #define PINKIE_CFG_SSCANF_MAX_INT       8
 
 
+/* Configure the maximum count of RegReg register entries. Each entry uses one
+ * pointer in the sorted register index.
+ */
+#define PINKIE_CFG_REGREG_ENTRIES       10
+
+
+/* Enable the RegReg register value cache. Slow registers like the ADC or
+ * RFM69 measurements are only read again after their TTL expired.
+ */
+#define PINKIE_CFG_REGREG_CACHE         1
+
+
+/* Enable RegReg value types. Multi-byte values are announced as a whole, so
+ * the host doesn't need to reassemble them. Plain reads stay byte-wise, the
+ * whole value is read with "reg read <addr> <range> t".
+ */
+#define PINKIE_CFG_REGREG_TYPES         1
+
+
+/* Configure the count of RegReg writes that are queued while a register is
+ * busy, e.g. by an outstanding PCA301 request. The queue is replayed from the
+ * main loop.
+ */
+#define PINKIE_CFG_REGREG_PEND_CNT      4
+
+
+/* Configure the byte count of the RegReg transaction log. Staged writes are
+ * applied together on commit, e.g. a full RFM69 frequency setting.
+ */
+#define PINKIE_CFG_REGREG_TXN_LEN       16
+
+
+/* Enable RegReg access statistics. Each static register entry gets 12 bytes
+ * of counters in RAM, selected by address on the statistics registers.
+ */
+#define PINKIE_CFG_REGREG_STATS         1
+
+
+/* Enable persistent RegReg registers. Writes to the NVS registers are written
+ * back after a quiet period, only the changed bytes are updated.
+ */
+#define PINKIE_CFG_REGREG_NVS           1
+
+
+/* Configure the count of RegReg announcement subscriptions. Once the host
+ * subscribed to a register range, announcements of other registers, e.g. the
+ * ATmega or RFM69 values, are dropped before they reach the UART. All PCA301
+ * outlets announce on the same registers, so outlets can't be filtered this
+ * way, only the PCA301 block as a whole.
+ */
+#define PINKIE_CFG_REGREG_ANN_SUB_CNT   4
+
+
+/* Configure the UART transmit buffer. Output is sent by the UART interrupt,
+ * so dumps don't stall the radio handling. Must be a power of two.
+ */
+#define PINKIE_CFG_UART_TX_LEN          128
+
+
+/* Enable deferred logging. The PCA301 diagnostics are sent as format ID and
+ * raw arguments and expanded on the host by
+ *   mods/log/tools/pinkie_log_decode.py build/atmega328/pinkie /dev/ttyUSB0
+ */
+#define PINKIE_CFG_LOG_DEFERRED         1
+
+
+/* Limit the log levels. Frame dumps are debug output and not compiled in, the
+ * runtime level (register 5900) selects between errors, warnings and info.
+ */
+#define PINKIE_CFG_LOG_LVL              PINKIE_LOG_LVL_INFO
+#define PINKIE_CFG_LOG_LVL_INIT         PINKIE_LOG_LVL_INFO
+
+
 #endif /* PINKIE_CFG_H */
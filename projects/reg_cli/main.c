@@ -15,27 +15,16 @@
 /* Local variables */
 /*****************************************************************************/
 static uint8_t reg_data[0x21] = { 0 };          /**< virtual registers */
+static uint8_t reg_data_be16[4] = { 0 };        /**< virtual big endian 16-bit registers */
 static ACYCLIC_T g_a = { 0 };                   /**< ACyCLIC handle */
 
 
 /*****************************************************************************/
 /* Register definitions */
 /*****************************************************************************/
-static REG_ENTRY_T reg_info_0000_001f = {
-    NULL,
-    0x0000,
-    0x001f,
-    NULL,
-    &reg_data[0],
-};
-
-static REG_ENTRY_T reg_info_0020_0020 = {
-    NULL,
-    0x0020,
-    0x0020,
-    NULL,
-    &reg_data[0x1f]
-};
+REGREG_ENTRY(reg_info_0000_001f, 0x0000, 0x001f, NULL, &reg_data[0]);
+REGREG_ENTRY(reg_info_0020_0020, 0x0020, 0x0020, NULL, &reg_data[0x20]);
+REGREG_ENTRY_TYPED(reg_info_0030_0033, 0x0030, 0x0033, NULL, reg_data_be16, REGREG_TYPE_I16 | REGREG_TYPE_BE);
 
 
 /*****************************************************************************/
@@ -57,10 +46,9 @@ int main(
         res = regreg_acyclic_init(&g_a);
     }
 
+    /* check registers */
     if (!res) {
-        /* add registers */
-        reg_add(&reg_info_0000_001f);
-        reg_add(&reg_info_0020_0020);
+        res = reg_init();
     }
 
     /* handle input */
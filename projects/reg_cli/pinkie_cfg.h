@@ -31,4 +31,27 @@
 #define PINKIE_CFG_SSCANF_MAX_INT       8
 
 
+/* Configure the pinkie_printf stack buffer. The output of each call is
+ * collected and passed to standard output in blocks instead of character by
+ * character. 0 disables the buffer.
+ */
+#define PINKIE_CFG_PRINTF_BUF_LEN       64
+
+
+/* Configure the maximum count of RegReg register entries. Each entry uses one
+ * pointer in the sorted register index.
+ */
+#define PINKIE_CFG_REGREG_ENTRIES       4
+
+
+/* Enable RegReg value types, so typed registers can be read as a whole. */
+#define PINKIE_CFG_REGREG_TYPES         1
+
+
+/* Enable RegReg access statistics per register entry. The statistics are
+ * listed by "reg stats".
+ */
+#define PINKIE_CFG_REGREG_STATS         1
+
+
 #endif /* PINKIE_CFG_H */
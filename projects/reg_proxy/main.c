@@ -0,0 +1,171 @@
+/**
+ * @brief Demonstration of RegReg remote register proxying in PINKIE
+ *
+ * Every started process is a node on a simulated radio channel. Node 0 is
+ * the gateway and mounts the registers of node 1 at address 4096. Each node
+ * maps its proxy statistics to address 8192.
+ *
+ * Usage: pinkie [node]
+ *
+ * Copyright (c) 2017, Sven Bachmann <dev@mcbachmann.de>
+ *
+ * Licensed under the MIT license, see LICENSE for details.
+ */
+#define _POSIX_C_SOURCE 200112L
+#include <pinkie.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <acyclic.h>
+#include <regreg.h>
+#include <regreg_acyclic.h>
+#include <regreg_proxy.h>
+#include <radio_sim.h>
+
+
+/*****************************************************************************/
+/* Local defines */
+/*****************************************************************************/
+#define NODE_GW                         0       /**< gateway node */
+#define NODE_REMOTE                     1       /**< remote node */
+
+#define REG_BASE_REMOTE                 4096    /**< regreg base of remote window */
+#define REG_BASE_PROXY                  8192    /**< regreg base proxy statistics */
+
+#define REMOTE_LEN                      0x20    /**< remote window length */
+#define REMOTE_TTL_MS                   2000    /**< remote window cache TTL */
+
+#define POLL_MS                         10      /**< main loop poll interval */
+
+
+/*****************************************************************************/
+/* Local variables */
+/*****************************************************************************/
+static uint8_t reg_data[0x20] = { 0 };          /**< virtual registers */
+static REGREG_PROXY_T proxy_remote;             /**< remote register window */
+static ACYCLIC_T g_a = { 0 };                   /**< ACyCLIC handle */
+
+static const PINKIE_FMT_OP_T fmt_ann[] = {      /**< announcement "ann addr:" */
+    PINKIE_FMT_TEXT("ann "), PINKIE_FMT_U(REG_ADDR_T), PINKIE_FMT_TEXT(":"), PINKIE_FMT_END
+};
+static const PINKIE_FMT_OP_T fmt_ann_byte[] = { /**< announcement " 0xval" */
+    PINKIE_FMT_TEXT(" 0x"), PINKIE_FMT_X0(uint8_t, 2), PINKIE_FMT_END
+};
+
+
+/*****************************************************************************/
+/* Register definitions */
+/*****************************************************************************/
+REGREG_ENTRY(reg_info_0000_001f, 0x0000, 0x001f, NULL, reg_data);
+
+
+/*****************************************************************************/
+/** Main
+ */
+int main(
+    int argc,                                   /**< argument count */
+    char **argv                                 /**< arguments */
+)
+{
+    int res;                                    /* result */
+    uint8_t node = NODE_GW;                     /* own node id */
+    uint8_t frm[RADIO_SIM_FRAME_LEN];           /* received frame */
+    uint8_t len;                                /* frame length */
+    char chr;                                   /* input character */
+    struct pollfd fds[2];                       /* poll descriptors */
+
+    if (1 < argc) {
+        node = (uint8_t) atoi(argv[1]);
+    }
+
+    res = radio_sim_init(node);
+    if (res) {
+        fprintf(stderr, "Couldn't join radio channel as node %u\n", node);
+        return 1;
+    }
+
+    res = pinkie_stdio_init();
+
+    if (!res) {
+        res = acyclic_init(&g_a);
+    }
+
+    if (!res) {
+        res = regreg_acyclic_init(&g_a);
+    }
+
+    /* check registers */
+    if (!res) {
+        res = reg_init();
+    }
+
+    /* answer remote requests and map proxy statistics */
+    if (!res) {
+        res = reg_proxy_init(REG_BASE_PROXY, node);
+    }
+
+    /* mount remote node on gateway */
+    if ((!res) && (NODE_GW == node)) {
+        res = reg_proxy_mount(&proxy_remote, REG_BASE_REMOTE, REMOTE_LEN, NODE_REMOTE, 0, REMOTE_TTL_MS);
+    }
+
+    fds[0].fd = STDIN_FILENO;
+    fds[0].events = POLLIN;
+    fds[1].fd = radio_sim_fd();
+    fds[1].events = POLLIN;
+
+    /* handle input and radio frames */
+    while ((!res) && (!g_a.flg_exit)) {
+        fflush(stdout);
+        poll(fds, 2, POLL_MS);
+
+        /* frames first, so input sees the latest remote state */
+        while (0 != (len = radio_sim_recv(frm, sizeof(frm)))) {
+            reg_proxy_input(frm, len);
+        }
+
+        reg_proxy_process();
+
+        if (fds[0].revents) {
+            if (1 != read(STDIN_FILENO, &chr, 1)) {
+                break;
+            }
+            acyclic_input(&g_a, (uint8_t) chr);
+        }
+    }
+
+    pinkie_stdio_exit();
+
+    return res;
+}
+
+
+/*****************************************************************************/
+/** Send proxy frame on simulated radio channel
+ */
+PINKIE_RES_T reg_proxy_send(
+    const uint8_t *data,                        /**< frame */
+    unsigned int len                            /**< frame length */
+)
+{
+    return radio_sim_send(data, (uint8_t) len);
+}
+
+
+/*****************************************************************************/
+/** Announce register content
+ */
+void reg_ann(
+    REG_ADDR_T addr,                            /**< register address */
+    void *data,                                 /**< data */
+    unsigned int len                            /**< data length */
+)
+{
+    unsigned int cnt;                           /* counter */
+
+    pinkie_printf_fmt(fmt_ann, addr);
+    for (cnt = 0; cnt < len; cnt++) {
+        pinkie_printf_fmt(fmt_ann_byte, ((uint8_t *) data)[cnt]);
+    }
+    pinkie_printf("\n");
+}